@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <thread>
+
 #include <asco/util/types.h>
 
 #if defined(_MSC_VER)
@@ -66,4 +69,15 @@ inline void exp_withdraw(std::size_t i) noexcept {
     }
 }
 
+// 排队自旋锁的等待者不能退出队列，自旋超过一定次数后让出 CPU ，
+// 避免线程数多于核心数时排在前面的线程得不到调度
+inline void relax_or_yield(std::size_t &i) noexcept {
+    if (i < 1024) {
+        i++;
+        concurrency::cpu_relax();
+    } else {
+        std::this_thread::yield();
+    }
+}
+
 };  // namespace asco::concurrency
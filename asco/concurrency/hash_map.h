@@ -544,6 +544,19 @@ public:
         return true;
     }
 
+    // 扩容到插入 n 个元素之前都不需要 rehash
+    void reserve(std::size_t n) {
+        while (true) {
+            if (auto rg = m_lock.try_write()) {
+                while (static_cast<double>(n) >= m_buckets.size() * load_factor) {
+                    do_rehash();
+                }
+                return;
+            }
+            concurrency::cpu_relax();
+        }
+    }
+
 private:
     std::expected<std::monostate, insert_failed>
     do_insert(const K &key, util::types::monostate_if_void<V> &&value) {
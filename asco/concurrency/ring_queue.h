@@ -14,6 +14,7 @@
 #include <type_traits>
 #include <utility>
 
+#include <asco/core/mm/pages.h>
 #include <asco/util/consts.h>
 #include <asco/util/raw_storage.h>
 #include <asco/util/types.h>
@@ -313,6 +314,14 @@ public:
         }
     }
 
+    // 近似判断队列是否为空，结果只在调用瞬间有效
+    bool empty() const noexcept
+        requires(!std::is_void_v<T>)
+    {
+        return m_stor->head.load(std::memory_order::acquire) ==
+               m_stor->tail.load(std::memory_order::acquire);
+    }
+
     bool try_recv()
         requires(std::is_void_v<T>)
     {
@@ -337,7 +346,8 @@ private:
 template<util::types::move_secure T, std::size_t Cap>
     requires(Cap != std::numeric_limits<std::size_t>::max())
 std::pair<sender<T, Cap>, receiver<T, Cap>> create() {
-    auto stor = std::make_shared<storage<T, Cap>>();
+    // 大容量队列的存储在开启大页时映射大页
+    auto stor = std::allocate_shared<storage<T, Cap>>(core::mm::large_allocator<storage<T, Cap>>{});
     return std::make_pair(sender<T, Cap>{stor}, receiver<T, Cap>{stor});
 }
 
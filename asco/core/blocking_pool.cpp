@@ -0,0 +1,169 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <asco/core/blocking_pool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+#include <asco/core/runtime.h>
+
+namespace asco::core {
+
+blocking_pool::blocking_pool(std::size_t max_threads, std::chrono::nanoseconds keep_alive, void *runtime_ptr)
+        : m_max_threads{max_threads ? max_threads : 1}
+        , m_keep_alive{keep_alive}
+        , m_runtime_ptr{runtime_ptr} {}
+
+blocking_pool::~blocking_pool() { shutdown(); }
+
+void blocking_pool::shutdown() {
+    // 线程停止前会在自己的 shutdown() 中取完队列中剩下的任务，因此不会留下永远等不到结果的 join_handle
+    // 这些任务还可能提交新的阻塞任务并启动新线程，因此反复 join 直到没有线程
+    while (true) {
+        std::vector<std::unique_ptr<thread>> threads;
+        {
+            auto g = m_threads.lock();
+            threads = std::move(*g);
+        }
+        if (threads.empty()) {
+            return;
+        }
+        for (auto &t : threads) {
+            t->join();
+        }
+    }
+}
+
+void blocking_pool::submit(job &&j) {
+    thread *idle{nullptr};
+    {
+        auto g = m_state.lock();
+        g->jobs.push_back(std::move(j));
+        if (!g->idle.empty()) {
+            idle = g->idle.back();
+            g->idle.pop_back();
+        }
+    }
+    if (idle) {
+        idle->awake();
+        return;
+    }
+
+    // 没有空闲线程：未达上限时启动一个新线程，否则任务留在队列中等待已有线程取走
+    auto n = m_nthreads.load(std::memory_order::acquire);
+    while (n < m_max_threads) {
+        if (m_nthreads.compare_exchange_weak(
+                n, n + 1, std::memory_order::acq_rel, std::memory_order::acquire)) {
+            reap_retired();
+            auto t = std::make_unique<thread>(*this, m_next_id.fetch_add(1, std::memory_order::relaxed));
+            m_threads.lock()->push_back(std::move(t));
+            return;
+        }
+    }
+}
+
+void blocking_pool::bind_runtime() noexcept {
+    runtime::_current_runtime = reinterpret_cast<runtime *>(m_runtime_ptr);
+}
+
+void blocking_pool::reap_retired() {
+    std::vector<std::unique_ptr<thread>> retired;
+    {
+        auto g = m_threads.lock();
+        for (auto it = g->begin(); it != g->end();) {
+            if ((*it)->retired()) {
+                retired.push_back(std::move(*it));
+                it = g->erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    // 已退出的线程在这里析构，join 不会长时间阻塞
+}
+
+blocking_pool::thread::thread(blocking_pool &pool, std::size_t id)
+        : daemon{std::format("asco::b{}", id)}
+        , m_pool{pool} {
+    auto _ = daemon::start();
+}
+
+bool blocking_pool::thread::init() {
+    m_pool.bind_runtime();
+    return true;
+}
+
+bool blocking_pool::thread::run_once(std::stop_token &st) {
+    std::optional<job> j;
+    {
+        auto g = m_pool.m_state.lock();
+        if (!g->jobs.empty()) {
+            j.emplace(std::move(g->jobs.front()));
+            g->jobs.pop_front();
+        } else {
+            g->idle.push_back(this);
+        }
+    }
+
+    if (j) {
+        run(*j);
+        return true;
+    }
+
+    sleep_until_awake_for(m_pool.m_keep_alive);
+    if (st.stop_requested()) {
+        return false;
+    }
+
+    auto g = m_pool.m_state.lock();
+    if (auto it = std::ranges::find(g->idle, this); it != g->idle.end()) {
+        // 保活时间内没有等到新任务，线程退出，由之后的 submit 回收
+        g->idle.erase(it);
+        m_pool.m_nthreads.fetch_sub(1, std::memory_order::acq_rel);
+        m_retired.store(true, std::memory_order::release);
+        return false;
+    }
+    // 已被 submit 从空闲列表中取出并唤醒
+    return true;
+}
+
+void blocking_pool::thread::shutdown() {
+    if (retired()) {
+        return;
+    }
+    // 被要求停止：取完队列中剩下的任务再退出
+    // 判断队列为空与减少线程数在同一临界区内，之后提交的任务会由 submit 启动新线程运行
+    while (true) {
+        std::optional<job> j;
+        {
+            auto g = m_pool.m_state.lock();
+            if (auto it = std::ranges::find(g->idle, this); it != g->idle.end()) {
+                g->idle.erase(it);
+            }
+            if (g->jobs.empty()) {
+                m_pool.m_nthreads.fetch_sub(1, std::memory_order::acq_rel);
+                m_retired.store(true, std::memory_order::release);
+                return;
+            }
+            j.emplace(std::move(g->jobs.front()));
+            g->jobs.pop_front();
+        }
+        run(*j);
+    }
+}
+
+void blocking_pool::thread::run(job &j) {
+    _current_job = &j;
+    j.invoke(j.fn);
+    _current_job = nullptr;
+}
+
+};  // namespace asco::core
@@ -0,0 +1,106 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <asco/core/cancellation.h>
+#include <asco/core/daemon.h>
+#include <asco/core/mm/task_arena.h>
+#include <asco/sync/spinlock.h>
+#include <asco/util/erased.h>
+#include <asco/util/safe_erased.h>
+
+namespace asco::core {
+
+// spawn_blocking 的专用线程池：按需增长到上限，空闲超过保活时间的线程自动退出
+// 阻塞闭包只在这里运行，永远不会占用异步 worker
+class blocking_pool final {
+public:
+    struct job {
+        util::erased fn;
+        void (*invoke)(util::erased &fn) noexcept;
+        util::safe_erased tls;
+        cancel_token token;
+        mm::task_arena::handle arena{};
+
+        template<std::invocable<> Fn>
+        static job create(Fn &&fn, util::safe_erased &&tls, cancel_token token) {
+            using fn_type = std::remove_cvref_t<Fn>;
+            return job{
+                util::erased{fn_type{std::forward<Fn>(fn)}},
+                [](util::erased &f) noexcept { std::invoke(f.get<fn_type>()); }, std::move(tls),
+                std::move(token)};
+        }
+    };
+
+    blocking_pool(std::size_t max_threads, std::chrono::nanoseconds keep_alive, void *runtime_ptr);
+    ~blocking_pool();
+
+    blocking_pool(const blocking_pool &) = delete;
+    blocking_pool &operator=(const blocking_pool &) = delete;
+
+    void submit(job &&j);
+
+    // 停止所有线程，返回前队列中的任务（包括停止期间新提交的任务）都已运行完；之后仍可继续提交
+    void shutdown();
+
+    // 当前线程正在运行的阻塞任务，不在阻塞线程上时返回 nullptr
+    static job *current_job() noexcept { return _current_job; }
+
+    std::size_t thread_count() const noexcept { return m_nthreads.load(std::memory_order::acquire); }
+
+private:
+    class thread final : public daemon {
+    public:
+        thread(blocking_pool &pool, std::size_t id);
+
+        // 线程已经因空闲超时或停止而退出，可以被回收
+        bool retired() const noexcept { return m_retired.load(std::memory_order::acquire); }
+
+        using daemon::join;
+
+    private:
+        bool init() override;
+        bool run_once(std::stop_token &st) override;
+        void shutdown() override;
+
+        void run(job &j);
+
+        blocking_pool &m_pool;
+        std::atomic_bool m_retired{false};
+    };
+
+    struct queue_state {
+        std::deque<job> jobs;
+        std::vector<thread *> idle;
+    };
+
+    void bind_runtime() noexcept;
+    void reap_retired();
+
+    const std::size_t m_max_threads;
+    const std::chrono::nanoseconds m_keep_alive;
+    void *m_runtime_ptr;
+
+    std::atomic_size_t m_nthreads{0};
+    std::atomic_size_t m_next_id{0};
+
+    sync::spinlock<queue_state> m_state;
+    sync::spinlock<std::vector<std::unique_ptr<thread>>> m_threads;
+
+    inline thread_local static job *_current_job{nullptr};
+};
+
+};  // namespace asco::core
@@ -3,8 +3,8 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
-#include <stop_token>
 
 namespace asco::core {
 
@@ -21,6 +21,13 @@ class cancel_source final {
 public:
     cancel_source() = default;
 
+    // token 持有指向 source 的指针，source 在整个生命周期中地址不变
+    cancel_source(const cancel_source &) = delete;
+    cancel_source &operator=(const cancel_source &) = delete;
+
+    cancel_source(cancel_source &&) = delete;
+    cancel_source &operator=(cancel_source &&) = delete;
+
     cancel_token get_token() noexcept;
 
     void request_cancel() noexcept;
@@ -28,7 +35,8 @@ public:
     void invoke_callbacks() noexcept;
 
 private:
-    std::stop_source m_stop_source{};
+    // 只是一个标志位，不像 std::stop_source 那样在堆上分配共享状态
+    std::atomic_bool m_cancel_requested{false};
 };
 
 class cancel_token final {
@@ -45,11 +53,9 @@ public:
     operator bool() const noexcept;
 
 private:
-    cancel_token(cancel_source &source, std::stop_token token) noexcept;
+    explicit cancel_token(cancel_source &source) noexcept;
 
-    bool m_valid{false};
     cancel_source *m_source{nullptr};
-    std::stop_token m_stop_token;
 };
 
 class cancel_callback final {
@@ -0,0 +1,214 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <asco/core/mm/buffer_pool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+#include <asco/core/mm/pages.h>
+#include <asco/core/os/memory.h>
+
+namespace asco::core::mm {
+
+namespace {
+
+class buffer_resource final : public std::pmr::memory_resource {
+private:
+    // 对齐要求超过 max_align_t 的分配不经过池
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (alignment > alignof(std::max_align_t)) {
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        if (auto p = buffer_pool::allocate(bytes)) {
+            return p;
+        }
+        throw std::bad_alloc{};
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+        if (alignment > alignof(std::max_align_t)) {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            return;
+        }
+        buffer_pool::deallocate(p, bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+};
+
+};  // namespace
+
+std::pmr::memory_resource &buffer_pool::resource() noexcept {
+    static buffer_resource res;
+    return res;
+}
+
+std::pmr::polymorphic_allocator<> &buffer_pool::allocator() noexcept {
+    static std::pmr::polymorphic_allocator<> alloc{&resource()};
+    return alloc;
+}
+
+buffer_pool &buffer_pool::get() noexcept {
+    // 池对象本身不释放：线程退出后，其它线程上仍可能有属于它的缓冲区等待归还
+    struct local_pool {
+        buffer_pool *pool{new buffer_pool};
+        ~local_pool() { pool->orphan(); }
+    };
+    thread_local local_pool _pool{};
+    return *_pool.pool;
+}
+
+std::size_t buffer_pool::class_of(std::size_t n) noexcept {
+    if (n > max_class_size - sizeof(header)) {
+        return size_classes;
+    }
+    auto total = std::max(n + sizeof(header), min_class_size);
+    return std::bit_width(total - 1) - std::bit_width(min_class_size - 1);
+}
+
+void *buffer_pool::allocate(std::size_t n) noexcept {
+    auto index = class_of(n);
+    if (index == size_classes) [[unlikely]] {
+        return ::operator new(n, std::nothrow);
+    }
+
+    auto &self = get();
+    if (!self.m_freelist[index] && self.m_remote_frees.load(std::memory_order::relaxed)) {
+        self.drain_remote();
+    }
+
+    auto hdr = self.m_freelist[index];
+    if (hdr) {
+        self.m_freelist[index] = hdr->next;
+        self.m_cached_buffers--;
+        self.m_cached_bytes -= class_size(index);
+    } else {
+        hdr = allocate_buffer(&self, index);
+        if (!hdr) {
+            return nullptr;
+        }
+    }
+    return hdr + 1;
+}
+
+void buffer_pool::deallocate(void *addr, std::size_t n) noexcept {
+    if (class_of(n) == size_classes) [[unlikely]] {
+        ::operator delete(addr, n);
+        return;
+    }
+
+    auto hdr = static_cast<header *>(addr) - 1;
+    auto &self = get();
+    if (hdr->owner != &self) [[unlikely]] {
+        hdr->owner->push_remote(hdr);
+        return;
+    }
+    self.free_local(hdr);
+}
+
+buffer_pool::header *buffer_pool::allocate_buffer(buffer_pool *owner, std::size_t index) noexcept {
+    auto size = class_size(index);
+    void *mem = nullptr;
+    bool mapped = false;
+    // 开启大页时，恰好占满整数个大页的缓冲区直接映射大页
+    if (huge_pages_enabled() && size % os::huge_page_size == 0) {
+        mem = os::map_pages(size, true);
+        mapped = mem != nullptr;
+    }
+    if (!mem) {
+        mem = ::operator new(size, std::nothrow);
+        if (!mem) {
+            return nullptr;
+        }
+    }
+    return new (mem) header{owner, nullptr, static_cast<std::uint32_t>(index), mapped};
+}
+
+void buffer_pool::release_buffer(header *hdr) noexcept {
+    auto size = class_size(hdr->index);
+    if (hdr->mapped) {
+        os::unmap_pages(hdr, size);
+    } else {
+        ::operator delete(hdr, size);
+    }
+}
+
+void buffer_pool::free_local(header *hdr) noexcept {
+    auto size = class_size(hdr->index);
+    if (m_cached_bytes + size > max_cached_bytes) {
+        release_buffer(hdr);
+        return;
+    }
+    hdr->next = m_freelist[hdr->index];
+    m_freelist[hdr->index] = hdr;
+    m_cached_buffers++;
+    m_cached_bytes += size;
+}
+
+void buffer_pool::push_remote(header *hdr) noexcept {
+    if (m_orphaned.load(std::memory_order::acquire)) {
+        release_buffer(hdr);
+        return;
+    }
+
+    auto head = m_remote_frees.load(std::memory_order::relaxed);
+    do {
+        hdr->next = head;
+    } while (!m_remote_frees.compare_exchange_weak(
+        head, hdr, std::memory_order::release, std::memory_order::relaxed));
+    m_pending_remote_frees.fetch_add(1, std::memory_order::relaxed);
+    m_total_remote_frees.fetch_add(1, std::memory_order::relaxed);
+}
+
+void buffer_pool::drain_remote() noexcept {
+    auto hdr = m_remote_frees.exchange(nullptr, std::memory_order::acquire);
+    std::size_t count = 0;
+    while (hdr) {
+        auto next = hdr->next;
+        free_local(hdr);
+        hdr = next;
+        ++count;
+    }
+    m_pending_remote_frees.fetch_sub(count, std::memory_order::relaxed);
+}
+
+void buffer_pool::orphan() noexcept {
+    m_orphaned.store(true, std::memory_order::seq_cst);
+
+    // 与置位并发的归还可能仍会进入队列，这些缓冲区不再被取回
+    auto hdr = m_remote_frees.exchange(nullptr, std::memory_order::acquire);
+    while (hdr) {
+        auto next = hdr->next;
+        release_buffer(hdr);
+        hdr = next;
+    }
+
+    for (auto &head : m_freelist) {
+        while (head) {
+            auto next = head->next;
+            release_buffer(head);
+            head = next;
+        }
+    }
+    m_cached_buffers = 0;
+    m_cached_bytes = 0;
+}
+
+buffer_pool::occupancy buffer_pool::local_occupancy() noexcept {
+    auto &self = get();
+    return {
+        self.m_cached_buffers,
+        self.m_cached_bytes,
+        self.m_pending_remote_frees.load(std::memory_order::relaxed),
+        self.m_total_remote_frees.load(std::memory_order::relaxed),
+    };
+}
+
+};  // namespace asco::core::mm
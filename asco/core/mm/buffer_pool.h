@@ -0,0 +1,94 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace asco::core::mm {
+
+// io::buffer 的默认内存来源
+// 每个线程持有按大小分级的缓存，分配与本线程上的释放不加锁；
+// 在其它线程上释放的缓冲区进入所属线程的无锁归还队列，由所属线程成批取回
+class buffer_pool {
+public:
+    buffer_pool(const buffer_pool &) = delete;
+    buffer_pool &operator=(const buffer_pool &) = delete;
+
+    buffer_pool(buffer_pool &&) = delete;
+    buffer_pool &operator=(buffer_pool &&) = delete;
+
+    // 返回按 max_align_t 对齐的内存，失败时返回 nullptr
+    static void *allocate(std::size_t n) noexcept;
+    static void deallocate(void *addr, std::size_t n) noexcept;
+
+    // 转发到 allocate/deallocate 的内存资源，本身无状态，可在任意线程上使用
+    static std::pmr::memory_resource &resource() noexcept;
+    static std::pmr::polymorphic_allocator<> &allocator() noexcept;
+
+    // 级别 i 的缓冲区连同头部共占 min_class_size << i 字节，超过最大级别的缓冲区直接向系统分配
+    static constexpr std::size_t min_class_size = 512;
+    static constexpr std::size_t size_classes = 13;
+    static constexpr std::size_t max_class_size = min_class_size << (size_classes - 1);
+
+    // 恰好占满 class_bytes 字节级别的最大请求字节数
+    static constexpr std::size_t class_capacity(std::size_t class_bytes) noexcept {
+        return class_bytes - sizeof(header);
+    }
+
+    // 每个线程缓存的空闲缓冲区字节数上限，超出部分直接归还系统
+    static constexpr std::size_t max_cached_bytes = 16 * 1024 * 1024;
+
+    struct occupancy {
+        std::size_t cached_buffers;        // 缓存的空闲缓冲区数量
+        std::size_t cached_bytes;          // 缓存的空闲缓冲区字节数
+        std::size_t pending_remote_frees;  // 其它线程已归还、尚未被本线程取回的缓冲区数量
+        std::size_t remote_frees;          // 累计收到的跨线程归还次数
+    };
+
+    // 当前线程的池占用情况
+    static occupancy local_occupancy() noexcept;
+
+private:
+    static buffer_pool &get() noexcept;
+
+    buffer_pool() noexcept = default;
+
+    // 位于每个池化缓冲区之前
+    struct alignas(std::max_align_t) header {
+        buffer_pool *owner;
+        header *next;  // 在缓存或归还队列中时使用
+        std::uint32_t index;
+        bool mapped;  // 直接从系统映射的大页，释放时解除映射
+    };
+
+    // n 为请求的字节数，返回 size_classes 表示不池化
+    static std::size_t class_of(std::size_t n) noexcept;
+    static std::size_t class_size(std::size_t index) noexcept { return min_class_size << index; }
+
+    static header *allocate_buffer(buffer_pool *owner, std::size_t index) noexcept;
+    static void release_buffer(header *hdr) noexcept;
+
+    void free_local(header *hdr) noexcept;
+    void push_remote(header *hdr) noexcept;
+    void drain_remote() noexcept;
+    // 线程退出：释放缓存，此后到达的跨线程归还直接释放
+    void orphan() noexcept;
+
+    std::array<header *, size_classes> m_freelist{};
+
+    std::atomic<header *> m_remote_frees{nullptr};
+    std::atomic_size_t m_pending_remote_frees{0};
+    std::atomic_size_t m_total_remote_frees{0};
+    std::atomic_bool m_orphaned{false};
+
+    // 只由所属线程写入
+    std::size_t m_cached_buffers{0};
+    std::size_t m_cached_bytes{0};
+};
+
+};  // namespace asco::core::mm
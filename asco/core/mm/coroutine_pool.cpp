@@ -3,13 +3,59 @@
 
 #include <asco/core/mm/coroutine_pool.h>
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <asco/core/mm/pages.h>
 #include <asco/core/mm/pool.h>
+#include <asco/core/os/memory.h>
+#include <asco/panic.h>
 
 namespace asco::core::mm {
 
+namespace {
+
+// 只由所属线程写入的计数器，不需要原子的读-改-写
+void add_relaxed(std::atomic_size_t &counter, std::size_t n) noexcept {
+    counter.store(counter.load(std::memory_order::relaxed) + n, std::memory_order::relaxed);
+}
+
+void sub_relaxed(std::atomic_size_t &counter, std::size_t n) noexcept {
+    counter.store(counter.load(std::memory_order::relaxed) - n, std::memory_order::relaxed);
+}
+
+struct pool_registry {
+    std::mutex mutex;
+    std::vector<coroutine_pool *> pools;
+};
+
+// 不析构：线程可能在静态对象析构之后才退出
+pool_registry &registry() noexcept {
+    static auto r = new pool_registry;
+    return *r;
+}
+
+};  // namespace
+
+coroutine_pool::coroutine_pool() noexcept
+        : m_thread{std::this_thread::get_id()} {
+    auto &r = registry();
+    std::lock_guard lk{r.mutex};
+    r.pools.push_back(this);
+}
+
 coroutine_pool &coroutine_pool::get() noexcept {
-    thread_local coroutine_pool _pool{};
-    return _pool;
+    // 池对象本身不释放：线程退出后，其它线程上仍可能有属于它的 block 的内存等待归还
+    struct local_pool {
+        coroutine_pool *pool{new coroutine_pool};
+        ~local_pool() { pool->orphan(); }
+    };
+    thread_local local_pool _pool{};
+    return *_pool.pool;
 }
 
 void *coroutine_pool::allocate(std::size_t n) noexcept {
@@ -26,31 +72,37 @@ void *coroutine_pool::allocate(std::size_t n) noexcept {
     self.allocate_count++;
 
     std::size_t index = (n - 1) / block_unit;
+    if (self.m_remote_frees.load(std::memory_order::relaxed)
+        && (!self.freelist[index]
+            || self.m_pending_remote_frees.load(std::memory_order::relaxed) >= remote_drain_batch)) {
+        self.drain_remote();
+    }
     if (auto obj = self.freelist[index]) {
         self.freelist[index] = obj->next;
+        sub_relaxed(self.m_cached_objects, 1);
+        sub_relaxed(self.m_cached_bytes, (index + 1) * block_unit);
+        sub_relaxed(self.m_cached[index], 1);
+        add_relaxed(self.m_in_use[index], 1);
 
         self.update_block_allocate_exp();
 
         return obj;
     }
 
+    if (self.m_reserved[index].load(std::memory_order::relaxed)) {
+        add_relaxed(self.m_overflows[index], 1);
+    }
+
     auto blist = self.blocks_list;
     while (blist) {
         if (auto ptr = blist->allocate(n)) {
+            add_relaxed(self.m_in_use[index], 1);
             return ptr;
         }
         if (blist->can_free()) {
             auto to_free = blist;
             blist = blist->next;
-            if (to_free->prev) {
-                to_free->prev->next = to_free->next;
-            } else {
-                self.blocks_list = to_free->next;
-            }
-            if (to_free->next) {
-                to_free->next->prev = to_free->prev;
-            }
-            pmr::get_local().deallocate_bytes(to_free, to_free->size);
+            self.free_block(to_free);
         } else {
             blist = blist->next;
         }
@@ -59,13 +111,13 @@ void *coroutine_pool::allocate(std::size_t n) noexcept {
     self.block_miss_count++;
     self.update_block_allocate_exp();
 
-    auto block_count = 1ull << self.block_allocate_exp;
-    block *new_block;
-    try {
-        new_block = reinterpret_cast<block *>(
-            pmr::get_local().allocate_bytes(max_object_size * block_count, alignof(block)));
-    } catch (const std::bad_alloc &) { return nullptr; }
-    new (new_block) block(block_count);
+    auto new_block = allocate_block(1ull << self.block_allocate_exp, &self);
+    if (!new_block) {
+        return nullptr;
+    }
+    add_relaxed(self.m_blocks, 1);
+    add_relaxed(self.m_block_bytes, new_block->size);
+    add_relaxed(self.m_in_use[index], 1);
 
     new_block->prev = nullptr;
     new_block->next = self.blocks_list;
@@ -89,19 +141,287 @@ void coroutine_pool::deallocate(void *addr, std::size_t n) noexcept {
 
     auto &self = get();
 
+    auto this_block = block_of(addr, n);
+    if (this_block->owner != &self) [[unlikely]] {
+        this_block->owner->push_remote(this_block, addr, n);
+        return;
+    }
+    self.free_local(addr, n);
+}
+
+void coroutine_pool::free_local(void *addr, std::size_t n) noexcept {
     std::size_t index = (n - 1) / block_unit;
+    sub_relaxed(m_in_use[index], 1);
 
-    if (self.freelist[index] == nullptr || self.freelist[index]->length <= giveback_threshold) {
+    auto threshold = std::max(giveback_threshold, m_reserved[index].load(std::memory_order::relaxed));
+    if (freelist[index] == nullptr || freelist[index]->length <= threshold) {
         auto obj = reinterpret_cast<object *>(addr);
-        obj->next = self.freelist[index];
-        obj->length = self.freelist[index] ? (self.freelist[index]->length + 1) : 1;
-        self.freelist[index] = obj;
+        obj->next = freelist[index];
+        obj->length = freelist[index] ? (freelist[index]->length + 1) : 1;
+        freelist[index] = obj;
+        add_relaxed(m_cached_objects, 1);
+        add_relaxed(m_cached_bytes, (index + 1) * block_unit);
+        add_relaxed(m_cached[index], 1);
+        return;
+    }
+
+    block_of(addr, n)->deallocate(addr, n);
+}
+
+void coroutine_pool::push_remote(block *blk, void *addr, std::size_t n) noexcept {
+    if (m_orphaned.load(std::memory_order::acquire)) {
+        if (blk->release_orphaned(block::needed_units(n))) {
+            release_block(blk);
+            s_orphaned_blocks.fetch_sub(1, std::memory_order::relaxed);
+        }
         return;
     }
 
-    auto this_block = reinterpret_cast<block *>(
-        reinterpret_cast<std::size_t *>(addr)[block::needed_units(n) * block_unit / sizeof(std::size_t) - 1]);
-    this_block->deallocate(addr, n);
+    auto obj = reinterpret_cast<object *>(addr);
+    obj->length = n;
+    auto head = m_remote_frees.load(std::memory_order::relaxed);
+    do {
+        obj->next = head;
+    } while (!m_remote_frees.compare_exchange_weak(
+        head, obj, std::memory_order::seq_cst, std::memory_order::relaxed));
+    m_pending_remote_frees.fetch_add(1, std::memory_order::relaxed);
+    m_total_remote_frees.fetch_add(1, std::memory_order::relaxed);
+
+    // 与 orphan 配对：要么 orphan 取走这次归还，要么这里看到所属线程已退出并自行取走
+    if (m_orphaned.load(std::memory_order::seq_cst)) [[unlikely]] {
+        release_orphaned_remote();
+    }
+}
+
+void coroutine_pool::drain_remote() noexcept {
+    auto obj = m_remote_frees.exchange(nullptr, std::memory_order::acquire);
+    std::size_t count = 0;
+    while (obj) {
+        auto next = obj->next;
+        free_local(obj, obj->length);
+        obj = next;
+        ++count;
+    }
+    m_pending_remote_frees.fetch_sub(count, std::memory_order::relaxed);
+}
+
+void coroutine_pool::orphan() noexcept {
+    m_orphaned.store(true, std::memory_order::seq_cst);
+
+    // 在此之前进入队列的归还与 freelist 中的对象都交还给所属 block
+    // 所属线程的引用尚未释放，这些归还不会使任何 block 被释放
+    auto obj = m_remote_frees.exchange(nullptr, std::memory_order::seq_cst);
+    while (obj) {
+        auto next = obj->next;
+        block_of(obj, obj->length)->deallocate(obj, obj->length);
+        obj = next;
+    }
+    for (std::size_t index = 0; index < size_classes; ++index) {
+        auto object_size = (index + 1) * block_unit;
+        while (auto cached = freelist[index]) {
+            freelist[index] = cached->next;
+            block_of(cached, object_size)->deallocate(cached, object_size);
+        }
+    }
+
+    // 释放所属线程的引用：已空闲的 block 立即释放，其余的由归还最后一个对象的线程释放
+    auto blist = blocks_list;
+    blocks_list = nullptr;
+    while (blist) {
+        auto next = blist->next;
+        s_orphaned_blocks.fetch_add(1, std::memory_order::relaxed);
+        if (blist->release_orphaned(1)) {
+            release_block(blist);
+            s_orphaned_blocks.fetch_sub(1, std::memory_order::relaxed);
+        }
+        blist = next;
+    }
+
+    auto &r = registry();
+    std::lock_guard lk{r.mutex};
+    std::erase(r.pools, this);
+}
+
+void coroutine_pool::release_orphaned_remote() noexcept {
+    auto obj = m_remote_frees.exchange(nullptr, std::memory_order::acquire);
+    while (obj) {
+        auto next = obj->next;
+        auto blk = block_of(obj, obj->length);
+        if (blk->release_orphaned(block::needed_units(obj->length))) {
+            release_block(blk);
+            s_orphaned_blocks.fetch_sub(1, std::memory_order::relaxed);
+        }
+        obj = next;
+    }
+}
+
+coroutine_pool::block *coroutine_pool::allocate_block(
+    std::size_t block_count, coroutine_pool *owner) noexcept {
+    // 直接向系统分配器申请，trim 释放的 block 会立即归还，而不是留在线程局部的 pmr 资源中
+    auto size = max_object_size * block_count;
+
+    // 开启大页时 block 至少占满一个大页，协程帧集中在少数 TLB 条目覆盖的范围内
+    if (huge_pages_enabled()) {
+        size = (size + os::huge_page_size - 1) / os::huge_page_size * os::huge_page_size;
+        if (auto mem = os::map_pages(size, true)) {
+            auto blk = new (mem) block(size / max_object_size, owner);
+            blk->mapped = true;
+            return blk;
+        }
+        size = max_object_size * block_count;
+    }
+
+    auto mem = ::operator new(size, std::align_val_t{alignof(block)}, std::nothrow);
+    if (!mem) {
+        return nullptr;
+    }
+    return new (mem) block(block_count, owner);
+}
+
+void coroutine_pool::free_block(block *blk) noexcept {
+    if (blk->prev) {
+        blk->prev->next = blk->next;
+    } else {
+        blocks_list = blk->next;
+    }
+    if (blk->next) {
+        blk->next->prev = blk->prev;
+    }
+    sub_relaxed(m_blocks, 1);
+    sub_relaxed(m_block_bytes, blk->size);
+    release_block(blk);
+}
+
+void coroutine_pool::release_block(block *blk) noexcept {
+    auto size = blk->size;
+    auto mapped = blk->mapped;
+    blk->~block();
+    if (mapped) {
+        os::unmap_pages(blk, size);
+    } else {
+        ::operator delete(blk, size, std::align_val_t{alignof(block)});
+    }
+}
+
+std::size_t coroutine_pool::trim_local(std::size_t target_cached_bytes) noexcept {
+    drain_remote();
+
+    // 从大对象开始把缓存的对象交还给所属 block
+    for (std::size_t index = size_classes; index-- > 0;) {
+        auto object_size = (index + 1) * block_unit;
+        auto reserved = m_reserved[index].load(std::memory_order::relaxed);
+        while (freelist[index] && m_cached[index].load(std::memory_order::relaxed) > reserved
+               && m_cached_bytes.load(std::memory_order::relaxed) > target_cached_bytes) {
+            auto obj = freelist[index];
+            freelist[index] = obj->next;
+            sub_relaxed(m_cached_objects, 1);
+            sub_relaxed(m_cached_bytes, object_size);
+            sub_relaxed(m_cached[index], 1);
+            block_of(obj, object_size)->deallocate(obj, object_size);
+        }
+    }
+
+    std::size_t released = 0;
+    auto blist = blocks_list;
+    while (blist) {
+        auto next = blist->next;
+        if (blist->can_free()) {
+            released += blist->size;
+            free_block(blist);
+        }
+        blist = next;
+    }
+
+    // 突发流量结束后从最小的 block 重新开始增长
+    block_allocate_exp = 0;
+    allocate_count = 0;
+    block_miss_count = 0;
+
+    add_relaxed(m_trimmed_bytes, released);
+    return released;
+}
+
+void coroutine_pool::reserve(std::size_t n, std::size_t count) noexcept {
+    auto size = needed_size(n);
+    if (size > max_object_size - block_unit || count == 0) {
+        return;
+    }
+
+    // 先全部分配再放回 freelist，预留的对象来自连续的 block
+    object *list = nullptr;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto obj = static_cast<object *>(allocate(n));
+        if (!obj) {
+            break;
+        }
+        obj->next = list;
+        list = obj;
+    }
+
+    auto &self = get();
+    add_relaxed(self.m_reserved[(size - 1) / block_unit], count);
+    while (list) {
+        auto next = list->next;
+        self.free_local(list, size);
+        list = next;
+    }
+}
+
+std::size_t coroutine_pool::trim(std::size_t target_cached_bytes) noexcept {
+    return get().trim_local(target_cached_bytes);
+}
+
+std::size_t coroutine_pool::trim_on_idle() noexcept {
+    auto &self = get();
+    if (self.m_cached_bytes.load(std::memory_order::relaxed) <= high_watermark()) {
+        return 0;
+    }
+    return self.trim_local(low_watermark());
+}
+
+void coroutine_pool::set_watermarks(std::size_t high, std::size_t low) noexcept {
+    if (low > high) {
+        panic("asco::core::mm::coroutine_pool::set_watermarks: 低水位 {} 高于高水位 {}", low, high);
+    }
+    s_high_watermark.store(high, std::memory_order::relaxed);
+    s_low_watermark.store(low, std::memory_order::relaxed);
+}
+
+coroutine_pool::occupancy coroutine_pool::snapshot() const noexcept {
+    occupancy res{
+        m_thread,
+        m_blocks.load(std::memory_order::relaxed),
+        m_block_bytes.load(std::memory_order::relaxed),
+        m_cached_objects.load(std::memory_order::relaxed),
+        m_cached_bytes.load(std::memory_order::relaxed),
+        m_pending_remote_frees.load(std::memory_order::relaxed),
+        m_total_remote_frees.load(std::memory_order::relaxed),
+        m_trimmed_bytes.load(std::memory_order::relaxed),
+        {},
+    };
+    for (std::size_t i = 0; i < size_classes; ++i) {
+        res.classes[i] = {
+            (i + 1) * block_unit,
+            m_in_use[i].load(std::memory_order::relaxed),
+            m_cached[i].load(std::memory_order::relaxed),
+            m_reserved[i].load(std::memory_order::relaxed),
+            m_overflows[i].load(std::memory_order::relaxed),
+        };
+    }
+    return res;
+}
+
+coroutine_pool::occupancy coroutine_pool::local_occupancy() noexcept { return get().snapshot(); }
+
+std::vector<coroutine_pool::occupancy> coroutine_pool::occupancy_report() {
+    auto &r = registry();
+    std::lock_guard lk{r.mutex};
+    std::vector<occupancy> res;
+    res.reserve(r.pools.size());
+    for (auto pool : r.pools) {
+        res.push_back(pool->snapshot());
+    }
+    return res;
 }
 
 void coroutine_pool::update_block_allocate_exp() noexcept {
@@ -109,14 +429,17 @@ void coroutine_pool::update_block_allocate_exp() noexcept {
         return;
     }
     if (allocate_count / block_miss_count <= 2) {
-        block_allocate_exp++;
+        if (block_allocate_exp < max_block_allocate_exp) {
+            block_allocate_exp++;
+        }
     } else {
         block_allocate_exp = block_allocate_exp == 0 ? 0 : block_allocate_exp - 1;
     }
 }
 
-coroutine_pool::block::block(std::size_t block_count) noexcept {
+coroutine_pool::block::block(std::size_t block_count, coroutine_pool *owner) noexcept {
     this->size = max_object_size * block_count;
+    this->owner = owner;
     this->unit_count = size / block_unit - 1;
 }
 
@@ -136,8 +459,13 @@ void coroutine_pool::block::deallocate(void *, std::size_t n) noexcept {
     gaveback_unit_count.fetch_add(units);
 }
 
+// 切分出去的单元全部归还时即可释放，不要求 block 已被切分完
 bool coroutine_pool::block::can_free() const noexcept {
-    return gaveback_unit_count.load(std::memory_order::acquire) == unit_count;
+    return gaveback_unit_count.load(std::memory_order::acquire) == allocating_index;
+}
+
+bool coroutine_pool::block::release_orphaned(std::size_t units) noexcept {
+    return gaveback_unit_count.fetch_add(units, std::memory_order::acq_rel) + units == allocating_index + 1;
 }
 
 };  // namespace asco::core::mm
@@ -5,6 +5,9 @@
 
 #include <array>
 #include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
 
 namespace asco::core::mm {
 
@@ -20,13 +23,70 @@ public:
     // needed_size(n) 的最后 8 字节是 `block *` ，用于在 deallocate 时将内存块回收到对应的 freelist 中
     static void *allocate(std::size_t n) noexcept;
 
+    // 在其它线程上释放的内存块先进入所属线程的跨线程归还队列，由所属线程成批取回
     static void deallocate(void *addr, std::size_t n) noexcept;
 
+    // n 字节的请求是否由 freelist 服务，否则绕过池直接通过 pmr 分配
+    static constexpr bool pooled(std::size_t n) noexcept {
+        return needed_size(n) <= max_object_size - block_unit;
+    }
+
+    // freelist 分配的对象按 64 字节为单位分为 63 个大小级别
+    static constexpr std::size_t size_classes = 63;
+
+    struct size_class_usage {
+        std::size_t object_size;  // 该级别对象占用的字节数
+        std::size_t in_use;       // 已分配且尚未归还到本线程的对象数量
+        std::size_t cached;       // freelist 中缓存的空闲对象数量
+        std::size_t reserved;     // 通过 reserve 预留的对象数量
+        std::size_t overflows;    // 预留的对象用尽后仍需分配的次数
+    };
+
+    // 单个线程的池占用情况
+    struct occupancy {
+        std::thread::id thread;
+        std::size_t blocks;                // 持有的 block 数量
+        std::size_t block_bytes;           // block 占用的总字节数
+        std::size_t cached_objects;        // freelist 中缓存的空闲对象数量
+        std::size_t cached_bytes;          // freelist 中缓存的空闲对象字节数
+        std::size_t pending_remote_frees;  // 其它线程已归还、尚未被本线程取回的对象数量
+        std::size_t remote_frees;          // 累计收到的跨线程归还次数
+        std::size_t trimmed_bytes;         // 累计通过 trim 归还给系统的 block 字节数
+        std::array<size_class_usage, size_classes> classes;
+    };
+
+    // 当前线程的池占用情况
+    static occupancy local_occupancy() noexcept;
+    // 所有存活线程的池占用情况，读取其它线程的计数不加锁，结果是近似值
+    static std::vector<occupancy> occupancy_report();
+
+    // 水位线作用于每个线程 freelist 中缓存的字节数：
+    // worker 空闲时若缓存超过高水位，则收缩到低水位
+    static void set_watermarks(std::size_t high, std::size_t low) noexcept;
+    static std::size_t high_watermark() noexcept { return s_high_watermark.load(std::memory_order::relaxed); }
+    static std::size_t low_watermark() noexcept { return s_low_watermark.load(std::memory_order::relaxed); }
+
+    // 在当前线程的 freelist 中预先缓存 count 个可容纳 n 字节的对象
+    // 预留的对象不受 giveback 阈值与 trim 影响，始终留在 freelist 中；预留用尽时计入 overflows
+    static void reserve(std::size_t n, std::size_t count) noexcept;
+
+    // 收缩当前线程的池：取回跨线程归还的对象，把 freelist 缓存削减到 target_cached_bytes 以下，
+    // 并释放所有单元均已归还的 block，返回释放的 block 字节数
+    static std::size_t trim(std::size_t target_cached_bytes = 0) noexcept;
+    // 缓存超过高水位时收缩到低水位，供 worker 空闲时调用
+    static std::size_t trim_on_idle() noexcept;
+
+    // 已退出线程留下、仍有对象未被其它线程归还的 block 数量；最后一个对象归还时 block 随即释放
+    static std::size_t orphaned_blocks() noexcept {
+        return s_orphaned_blocks.load(std::memory_order::relaxed);
+    }
+
 private:
     static coroutine_pool &get() noexcept;
 
-    static std::size_t needed_size(std::size_t n) noexcept { return ((n + 8) + 7) / 8 * 8; }
+    static constexpr std::size_t needed_size(std::size_t n) noexcept { return ((n + 8) + 7) / 8 * 8; }
 
+    // 在 freelist 中时 length 为链表长度；在跨线程归还队列中时 length 为 needed_size
     struct object {
         object *next;
         std::size_t length;
@@ -38,16 +98,28 @@ private:
 
     constexpr static std::size_t giveback_threshold = 1024;
 
-    coroutine_pool() = default;
+    // 跨线程归还队列中积累的对象达到此数量时，下一次分配会取回它们
+    constexpr static std::size_t remote_drain_batch = 64;
+
+    // 单个 block 最大为 4096 << max_block_allocate_exp 字节
+    constexpr static std::size_t max_block_allocate_exp = 10;
+
+    inline static std::atomic_size_t s_high_watermark{16 * 1024 * 1024};
+    inline static std::atomic_size_t s_low_watermark{4 * 1024 * 1024};
+    inline static std::atomic_size_t s_orphaned_blocks{0};
+
+    coroutine_pool() noexcept;
 
     // 对于索引 `i` 的 freelist ，其管理的内存块大小为 `block_unit * (i + 1)`
-    std::array<object *, 63> freelist{nullptr};
+    std::array<object *, size_classes> freelist{nullptr};
 
     // 最小的 block 大小为 4096 ，根据当前命中率动态调整每次分配的 block 大小（ 4096 的 2 的幂倍）
     struct alignas(max_object_size) block {
         std::size_t size;
         std::size_t unit_count;
         block *prev, *next;
+        coroutine_pool *owner;
+        bool mapped{false};  // 直接从系统映射的大页，释放时解除映射
         std::size_t allocating_index{0};
         std::atomic_size_t gaveback_unit_count{0};
 
@@ -55,15 +127,40 @@ private:
             char data[block_unit];
         } units[0];
 
-        block(std::size_t block_count) noexcept;
+        block(std::size_t block_count, coroutine_pool *owner) noexcept;
 
         void *allocate(std::size_t n) noexcept;
         void deallocate(void *addr, std::size_t n) noexcept;
         bool can_free() const noexcept;
+        // 所属线程退出后归还 units 个单元，返回是否应由调用方释放 block
+        // orphan 为每个 block 额外归还一个单元，代表所属线程持有的引用，因此恰好有一方看到计数到达终点
+        bool release_orphaned(std::size_t units) noexcept;
 
         static std::size_t needed_units(std::size_t n) noexcept { return (n - 1) / block_unit + 1; }
     };
 
+    // n 为 needed_size
+    static block *block_of(void *addr, std::size_t n) noexcept {
+        auto words = reinterpret_cast<std::size_t *>(addr);
+        auto trailer = block::needed_units(n) * block_unit / sizeof(std::size_t) - 1;
+        return reinterpret_cast<block *>(words[trailer]);
+    }
+
+    static block *allocate_block(std::size_t block_count, coroutine_pool *owner) noexcept;
+    // 从 blocks_list 摘下并释放
+    void free_block(block *blk) noexcept;
+    static void release_block(block *blk) noexcept;
+    std::size_t trim_local(std::size_t target_cached_bytes) noexcept;
+
+    // 以下 n 均为 needed_size
+    void free_local(void *addr, std::size_t n) noexcept;
+    void push_remote(block *blk, void *addr, std::size_t n) noexcept;
+    void drain_remote() noexcept;
+    // 线程退出：freelist 与跨线程归还队列中的对象交还给所属 block，释放已空闲的 block；
+    // 此后到达的跨线程归还直接计入对应 block，归还最后一个对象的线程释放该 block
+    void orphan() noexcept;
+    void release_orphaned_remote() noexcept;
+
     // 仅由当前线程回收 block
     block *blocks_list{nullptr};
     std::size_t block_allocate_exp{0};
@@ -72,6 +169,26 @@ private:
     std::size_t block_miss_count{0};
 
     void update_block_allocate_exp() noexcept;
+
+    // 其它线程归还的对象，无锁栈
+    std::atomic<object *> m_remote_frees{nullptr};
+    std::atomic_size_t m_pending_remote_frees{0};
+    std::atomic_size_t m_total_remote_frees{0};
+    std::atomic_bool m_orphaned{false};
+
+    // 占用统计：只由所属线程写入，供其它线程读取
+    const std::thread::id m_thread;
+    std::atomic_size_t m_blocks{0};
+    std::atomic_size_t m_block_bytes{0};
+    std::atomic_size_t m_cached_objects{0};
+    std::atomic_size_t m_cached_bytes{0};
+    std::atomic_size_t m_trimmed_bytes{0};
+    std::array<std::atomic_size_t, size_classes> m_in_use{};
+    std::array<std::atomic_size_t, size_classes> m_cached{};
+    std::array<std::atomic_size_t, size_classes> m_reserved{};
+    std::array<std::atomic_size_t, size_classes> m_overflows{};
+
+    occupancy snapshot() const noexcept;
 };
 
 };  // namespace asco::core::mm
@@ -0,0 +1,132 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <asco/core/mm/frame_profiler.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <print>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <asco/core/mm/coroutine_pool.h>
+#include <asco/core/os/symbols.h>
+
+namespace asco::core::mm {
+
+namespace {
+
+struct site_counters {
+    std::string_view promise;
+    std::size_t frame_size{0};
+    std::size_t allocations{0};
+    std::size_t live{0};
+    std::size_t peak_live{0};
+};
+
+struct profiler_state {
+    std::mutex mutex;
+    std::unordered_map<const void *, site_counters> sites;
+    // 存活的帧到其所属协程函数，unordered_map 的元素地址在 rehash 后不变
+    std::unordered_map<void *, site_counters *> frames;
+};
+
+// 有意泄漏：静态析构之后仍可能有帧被释放
+profiler_state &state() {
+    static profiler_state *s = [] {
+        auto res = new profiler_state;
+        std::atexit([] { frame_profiler::dump(); });
+        return res;
+    }();
+    return *s;
+}
+
+struct pending_frame {
+    void *frame;
+    std::size_t size;
+};
+
+thread_local pending_frame pending{nullptr, 0};
+
+};  // namespace
+
+void frame_profiler::on_allocate(void *frame, std::size_t size) noexcept { pending = {frame, size}; }
+
+void frame_profiler::on_construct(void *frame, std::string_view promise) noexcept {
+    if (!frame || pending.frame != frame) {
+        return;
+    }
+    auto size = pending.size;
+    pending = {nullptr, 0};
+
+    const void *resume_fn = *static_cast<void *const *>(frame);
+    auto &s = state();
+    std::lock_guard lk{s.mutex};
+    try {
+        auto &site = s.sites[resume_fn];
+        site.promise = promise;
+        site.frame_size = std::max(site.frame_size, size);
+        site.allocations++;
+        site.peak_live = std::max(site.peak_live, ++site.live);
+        s.frames[frame] = &site;
+    } catch (...) {
+        // 统计失败不影响协程本身
+    }
+}
+
+void frame_profiler::on_deallocate(void *frame) noexcept {
+    auto &s = state();
+    std::lock_guard lk{s.mutex};
+    if (auto it = s.frames.find(frame); it != s.frames.end()) {
+        it->second->live--;
+        s.frames.erase(it);
+    }
+}
+
+std::vector<frame_profiler::site> frame_profiler::report() {
+    std::vector<std::pair<const void *, site_counters>> snapshot;
+    {
+        auto &s = state();
+        std::lock_guard lk{s.mutex};
+        snapshot.assign(s.sites.begin(), s.sites.end());
+    }
+
+    // 符号解析较慢，不在锁内进行
+    std::vector<site> res;
+    res.reserve(snapshot.size());
+    for (auto &[resume_fn, c] : snapshot) {
+        res.push_back(site{
+            os::symbol_name(resume_fn), c.promise, c.frame_size, c.allocations, c.live, c.peak_live,
+            coroutine_pool::pooled(c.frame_size)});
+    }
+    std::ranges::sort(res, [](const site &a, const site &b) {
+        auto ab = a.frame_size * a.peak_live, bb = b.frame_size * b.peak_live;
+        return ab != bb ? ab > bb : a.allocations > b.allocations;
+    });
+    return res;
+}
+
+void frame_profiler::dump() {
+    auto sites = report();
+    if (sites.empty()) {
+        return;
+    }
+
+    std::println(stderr, "[ASCO] 协程帧统计（按峰值占用排序）：");
+    std::println(
+        stderr, "{:>10} {:>12} {:>8} {:>10} {:>12}  {}", "帧大小", "分配次数", "存活", "峰值存活", "峰值字节",
+        "协程函数");
+    for (auto &s : sites) {
+        std::println(
+            stderr, "{:>10} {:>12} {:>8} {:>10} {:>12}  {}{}", s.frame_size, s.allocations, s.live,
+            s.peak_live, s.frame_size * s.peak_live, s.name, s.pooled ? "" : " [绕过 coroutine_pool]");
+        std::println(stderr, "{:>58}{}", "", s.promise);
+    }
+}
+
+};  // namespace asco::core::mm
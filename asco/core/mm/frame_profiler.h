@@ -0,0 +1,42 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace asco::core::mm {
+
+// 按协程函数统计协程帧的大小、分配次数与存活数量，仅在 ASCO_PERF_RECORD 下由 promise 调用
+// 协程函数以帧开头的恢复函数指针区分，GCC、Clang 与 MSVC 都把它放在帧的首个字段
+// 进程退出时把统计结果按峰值占用排序输出到 stderr
+class frame_profiler {
+public:
+    frame_profiler() = delete;
+
+    // operator new 取得帧之后调用，此时帧头部还未写入
+    static void on_allocate(void *frame, std::size_t size) noexcept;
+    // get_return_object 中调用，此时帧头部已经写入，把刚分配的帧归属到协程函数
+    static void on_construct(void *frame, std::string_view promise) noexcept;
+    // operator delete 释放帧之前调用
+    static void on_deallocate(void *frame) noexcept;
+
+    struct site {
+        std::string name;            // 协程函数的符号名，无法解析时为 `模块+偏移`
+        std::string_view promise;    // promise 类型名
+        std::size_t frame_size;      // 向 coroutine_pool 请求的字节数，包含 join 状态
+        std::size_t allocations;     // 累计分配次数
+        std::size_t live;            // 当前存活的帧数量
+        std::size_t peak_live;       // 同时存活的帧数量峰值
+        bool pooled;                 // 为 false 时绕过了 coroutine_pool 的 freelist
+    };
+
+    // 按 frame_size * peak_live 降序排列
+    static std::vector<site> report();
+    static void dump();
+};
+
+};  // namespace asco::core::mm
@@ -0,0 +1,18 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <asco/core/mm/pages.h>
+
+namespace asco::core::mm {
+
+namespace {
+
+thread_local bool huge_pages{false};
+
+};  // namespace
+
+void set_huge_pages(bool enabled) noexcept { huge_pages = enabled; }
+
+bool huge_pages_enabled() noexcept { return huge_pages; }
+
+};  // namespace asco::core::mm
@@ -0,0 +1,92 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include <asco/core/os/memory.h>
+
+namespace asco::core::mm {
+
+// 线程级开关：开启后当前线程上 coroutine_pool 的 block、buffer_pool 的大缓冲区与大块存储改为映射大页，
+// 只影响之后的分配；runtime 在构造期间与自己的 worker 线程上打开，不影响其它线程
+void set_huge_pages(bool enabled) noexcept;
+bool huge_pages_enabled() noexcept;
+
+// enabled 为 true 时在作用域内打开当前线程的开关，离开作用域时恢复原值
+class huge_pages_scope {
+public:
+    explicit huge_pages_scope(bool enabled) noexcept
+            : m_prev{huge_pages_enabled()} {
+        if (enabled) {
+            set_huge_pages(true);
+        }
+    }
+
+    ~huge_pages_scope() { set_huge_pages(m_prev); }
+
+    huge_pages_scope(const huge_pages_scope &) = delete;
+    huge_pages_scope &operator=(const huge_pages_scope &) = delete;
+
+private:
+    bool m_prev;
+};
+
+// 不小于此尺寸的分配才映射大页，更小的分配会浪费大页的大部分空间
+inline constexpr std::size_t huge_page_threshold = os::huge_page_size / 2;
+
+// 长期存活的大块存储（例如 ring_queue 的存储）使用的分配器
+// 构造时决定是否使用大页，之后的释放沿用同一决定
+template<typename T>
+class large_allocator {
+    template<typename>
+    friend class large_allocator;
+
+public:
+    using value_type = T;
+
+    large_allocator() noexcept
+            : m_huge{huge_pages_enabled()} {}
+
+    template<typename U>
+    large_allocator(const large_allocator<U> &rhs) noexcept
+            : m_huge{rhs.m_huge} {}
+
+    T *allocate(std::size_t n) {
+        auto size = n * sizeof(T);
+        if (!mapped(size)) {
+            return std::allocator<T>{}.allocate(n);
+        }
+        if (auto p = os::map_pages(round_up(size), true)) {
+            return static_cast<T *>(p);
+        }
+        throw std::bad_alloc{};
+    }
+
+    void deallocate(T *p, std::size_t n) noexcept {
+        auto size = n * sizeof(T);
+        if (!mapped(size)) {
+            std::allocator<T>{}.deallocate(p, n);
+            return;
+        }
+        os::unmap_pages(p, round_up(size));
+    }
+
+    friend bool operator==(const large_allocator &, const large_allocator &) = default;
+
+private:
+    bool mapped(std::size_t size) const noexcept {
+        return m_huge && size >= huge_page_threshold && alignof(T) <= 4096;
+    }
+
+    static std::size_t round_up(std::size_t size) noexcept {
+        return (size + os::huge_page_size - 1) / os::huge_page_size * os::huge_page_size;
+    }
+
+    bool m_huge;
+};
+
+};  // namespace asco::core::mm
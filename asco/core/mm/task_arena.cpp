@@ -0,0 +1,93 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <asco/core/mm/task_arena.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <asco/core/mm/buffer_pool.h>
+
+namespace asco::core::mm {
+
+namespace {
+
+std::byte *align_up(std::byte *p, std::size_t alignment) noexcept {
+    auto addr = reinterpret_cast<std::uintptr_t>(p);
+    return p + ((alignment - addr % alignment) % alignment);
+}
+
+};  // namespace
+
+task_arena::handle task_arena::create() noexcept {
+    auto first = allocate_chunk(buffer_pool::class_capacity(min_chunk_size));
+    if (!first) {
+        return handle{};
+    }
+    return handle{new (first + 1) task_arena(first)};
+}
+
+task_arena::task_arena(chunk *first) noexcept
+        : m_chunks{first}
+        , m_cursor{reinterpret_cast<std::byte *>(this + 1)}
+        , m_end{reinterpret_cast<std::byte *>(first + 1) + first->size - sizeof(chunk)} {}
+
+task_arena::chunk *task_arena::allocate_chunk(std::size_t size) noexcept {
+    auto mem = buffer_pool::allocate(size);
+    if (!mem) {
+        return nullptr;
+    }
+    return new (mem) chunk{nullptr, size};
+}
+
+void *task_arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    if (auto p = align_up(m_cursor, alignment); bytes <= static_cast<std::size_t>(m_end - p)) {
+        m_cursor = p + bytes;
+        m_allocated_bytes += bytes;
+        return p;
+    }
+
+    auto capacity = buffer_pool::class_capacity(m_next_chunk_size) - sizeof(chunk);
+    // 超过新 chunk 一半的分配单独占用一个 chunk，当前 chunk 的剩余空间继续使用
+    if (bytes + alignment > capacity / 2) {
+        auto c = allocate_chunk(sizeof(chunk) + bytes + alignment);
+        if (!c) {
+            throw std::bad_alloc{};
+        }
+        c->next = m_chunks->next;
+        m_chunks->next = c;
+        m_chunk_count++;
+        m_allocated_bytes += bytes;
+        return align_up(reinterpret_cast<std::byte *>(c + 1), alignment);
+    }
+
+    auto c = allocate_chunk(buffer_pool::class_capacity(m_next_chunk_size));
+    if (!c) {
+        throw std::bad_alloc{};
+    }
+    c->next = m_chunks;
+    m_chunks = c;
+    m_chunk_count++;
+    m_next_chunk_size = std::min(m_next_chunk_size * 2, max_chunk_size);
+
+    auto p = align_up(reinterpret_cast<std::byte *>(c + 1), alignment);
+    m_cursor = p + bytes;
+    m_end = reinterpret_cast<std::byte *>(c + 1) + capacity;
+    m_allocated_bytes += bytes;
+    return p;
+}
+
+void task_arena::release() noexcept {
+    // this 位于第一个 chunk 中，析构之后再归还
+    auto c = m_chunks;
+    this->~task_arena();
+    while (c) {
+        auto next = c->next;
+        buffer_pool::deallocate(c, c->size);
+        c = next;
+    }
+}
+
+};  // namespace asco::core::mm
@@ -0,0 +1,62 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace asco::core::mm {
+
+// 任务作用域的 bump 分配区，通过 this_task::arena() 取得
+// chunk 来自 buffer_pool，分配只移动游标，单独的释放不回收内存，任务结束时所有 chunk 一并归还
+// 从中分配的内存不能比所属任务活得更久，例如不能作为任务的返回值交给其它任务
+class task_arena final : public std::pmr::memory_resource {
+public:
+    struct deleter {
+        void operator()(task_arena *arena) const noexcept { arena->release(); }
+    };
+    using handle = std::unique_ptr<task_arena, deleter>;
+
+    // task_arena 对象本身位于第一个 chunk 的开头，失败时返回空 handle
+    static handle create() noexcept;
+
+    // 可直接用于 io::buffer 与 pmr 容器
+    std::pmr::polymorphic_allocator<> &allocator() noexcept { return m_allocator; }
+
+    std::size_t chunk_count() const noexcept { return m_chunk_count; }
+    // 累计分配的字节数，不扣除已释放的部分
+    std::size_t allocated_bytes() const noexcept { return m_allocated_bytes; }
+
+    // chunk 的大小（包含 buffer_pool 的头部）从 min_chunk_size 开始倍增到 max_chunk_size
+    static constexpr std::size_t min_chunk_size = 4096;
+    static constexpr std::size_t max_chunk_size = 64 * 1024;
+
+private:
+    struct alignas(std::max_align_t) chunk {
+        chunk *next;
+        std::size_t size;  // 向 buffer_pool 请求的字节数
+    };
+
+    explicit task_arena(chunk *first) noexcept;
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+    static chunk *allocate_chunk(std::size_t size) noexcept;
+    void release() noexcept;
+
+    chunk *m_chunks;  // 当前切分的 chunk 在链表头部
+    std::byte *m_cursor;
+    std::byte *m_end;
+    std::size_t m_next_chunk_size{min_chunk_size * 2};
+    std::size_t m_chunk_count{1};
+    std::size_t m_allocated_bytes{0};
+    std::pmr::polymorphic_allocator<> m_allocator{this};
+};
+
+};  // namespace asco::core::mm
@@ -0,0 +1,58 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <asco/core/os/memory.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <sys/mman.h>
+
+namespace asco::core::os {
+
+namespace {
+
+constexpr int page_prot = PROT_READ | PROT_WRITE;
+constexpr int page_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+// log2(huge_page_size)，显式指定大页尺寸，避免系统默认大页不是 2 MiB
+constexpr int huge_page_shift = 21;
+static_assert(std::size_t{1} << huge_page_shift == huge_page_size);
+
+void *map(std::size_t size, int flags) noexcept {
+    auto p = ::mmap(nullptr, size, page_prot, flags, -1, 0);
+    return p == MAP_FAILED ? nullptr : p;
+}
+
+};  // namespace
+
+void *map_pages(std::size_t size, bool huge) noexcept {
+    if (!huge) {
+        return map(size, page_flags);
+    }
+
+    if (auto p = map(size, page_flags | MAP_HUGETLB | (huge_page_shift << MAP_HUGE_SHIFT))) {
+        return p;
+    }
+
+    // 没有预留的大页：多映射一个大页用于对齐，再把首尾多余的部分还给系统
+    auto raw = map(size + huge_page_size, page_flags);
+    if (!raw) {
+        return nullptr;
+    }
+    auto begin = reinterpret_cast<std::uintptr_t>(raw);
+    auto aligned = (begin + huge_page_size - 1) & ~(huge_page_size - 1);
+    if (auto head = aligned - begin) {
+        ::munmap(raw, head);
+    }
+    if (auto tail = begin + huge_page_size - aligned) {
+        ::munmap(reinterpret_cast<void *>(aligned + size), tail);
+    }
+    // 内核未开启透明大页时失败，此时仍可当作普通页使用
+    ::madvise(reinterpret_cast<void *>(aligned), size, MADV_HUGEPAGE);
+    return reinterpret_cast<void *>(aligned);
+}
+
+void unmap_pages(void *addr, std::size_t size) noexcept { ::munmap(addr, size); }
+
+};  // namespace asco::core::os
@@ -0,0 +1,40 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <asco/core/os/symbols.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <string>
+#include <string_view>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+
+namespace asco::core::os {
+
+std::string symbol_name(const void *addr) {
+    ::Dl_info info{};
+    if (!::dladdr(addr, &info)) {
+        return std::format("{}", addr);
+    }
+
+    if (info.dli_sname) {
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::string res{status == 0 && demangled ? demangled : info.dli_sname};
+        std::free(demangled);
+        return res;
+    }
+
+    // 局部符号不在动态符号表中，给出模块内偏移
+    std::string_view module{info.dli_fname ? info.dli_fname : "?"};
+    if (auto pos = module.rfind('/'); pos != std::string_view::npos) {
+        module.remove_prefix(pos + 1);
+    }
+    auto offset = reinterpret_cast<std::uintptr_t>(addr) - reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+    return std::format("{}+{:#x}", module, offset);
+}
+
+};  // namespace asco::core::os
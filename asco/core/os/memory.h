@@ -0,0 +1,20 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+
+namespace asco::core::os {
+
+inline constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+// 直接向系统映射 size 字节的匿名可读写内存，返回的地址至少按 4 KiB 对齐，失败时返回 nullptr
+// huge 为 true 时 size 必须是 huge_page_size 的整数倍：优先使用预留的大页，
+// 没有可用的大页时退化为普通页，并在系统支持时请求透明大页
+void *map_pages(std::size_t size, bool huge) noexcept;
+
+// size 必须与 map_pages 时相同
+void unmap_pages(void *addr, std::size_t size) noexcept;
+
+};  // namespace asco::core::os
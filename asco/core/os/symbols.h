@@ -0,0 +1,14 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <string>
+
+namespace asco::core::os {
+
+// 尽力把代码地址解析为可读的符号名
+// 无法解析时退化为 `模块+偏移` ，可交给 addr2line 等工具进一步解析
+std::string symbol_name(const void *addr);
+
+};  // namespace asco::core::os
@@ -0,0 +1,30 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <asco/core/os/memory.h>
+
+#include <cstddef>
+
+#include <windows.h>
+
+namespace asco::core::os {
+
+void *map_pages(std::size_t size, bool huge) noexcept {
+    // 大页需要 SeLockMemoryPrivilege 权限，且 size 必须是最小大页尺寸的整数倍
+    if (huge) {
+        auto large = ::GetLargePageMinimum();
+        if (large != 0 && size % large == 0) {
+            if (auto p = ::VirtualAlloc(
+                    nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE)) {
+                return p;
+            }
+        }
+    }
+
+    // Windows 没有透明大页，退化为普通页
+    return ::VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+void unmap_pages(void *addr, std::size_t) noexcept { ::VirtualFree(addr, 0, MEM_RELEASE); }
+
+};  // namespace asco::core::os
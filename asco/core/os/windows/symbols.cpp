@@ -0,0 +1,34 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <asco/core/os/symbols.h>
+
+#include <cstdint>
+#include <format>
+#include <string>
+#include <string_view>
+
+#include <windows.h>
+
+namespace asco::core::os {
+
+std::string symbol_name(const void *addr) {
+    // 符号名需要 dbghelp 与 pdb，这里只给出模块内偏移
+    ::HMODULE module{};
+    if (!::GetModuleHandleExA(
+            GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+            static_cast<LPCSTR>(addr), &module)) {
+        return std::format("{}", addr);
+    }
+
+    char path[MAX_PATH]{};
+    auto len = ::GetModuleFileNameA(module, path, MAX_PATH);
+    std::string_view name{path, len};
+    if (auto pos = name.find_last_of("\\/"); pos != std::string_view::npos) {
+        name.remove_prefix(pos + 1);
+    }
+    auto offset = reinterpret_cast<std::uintptr_t>(addr) - reinterpret_cast<std::uintptr_t>(module);
+    return std::format("{}+{:#x}", name, offset);
+}
+
+};  // namespace asco::core::os
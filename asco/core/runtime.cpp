@@ -3,12 +3,17 @@
 
 #include <asco/core/runtime.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <limits>
 #include <memory>
-#include <semaphore>
 #include <thread>
 #include <utility>
+#include <vector>
 
+#include <asco/core/mm/coroutine_pool.h>
+#include <asco/core/mm/pages.h>
 #include <asco/panic.h>
 
 namespace asco {
@@ -20,8 +25,13 @@ namespace core {
 runtime runtime_builder::build() && { return runtime(std::move(*this)); }
 
 runtime::runtime(runtime_builder &&builder)
-        : m_timer{std::move(builder.m_timer)}
-        , m_io_adapter{std::move(builder.m_io_adapter)} {
+        : m_max_pending_tasks{builder.m_max_pending_tasks}
+        , m_timer{std::move(builder.m_timer)}
+        , m_io_adapter{std::move(builder.m_io_adapter)}
+        , m_huge_pages{builder.m_huge_pages} {
+    // worker 的队列在当前线程上分配，构造结束后恢复当前线程原先的设置
+    mm::huge_pages_scope huge_pages{m_huge_pages};
+
     auto nthreads = builder.m_nthreads;
     if (nthreads == 0) {
         nthreads = std::thread::hardware_concurrency();
@@ -30,10 +40,15 @@ runtime::runtime(runtime_builder &&builder)
         }
     }
 
-    auto [tx, rx] = detail::coroutine_queue_create();
-    m_coroutine_tx = std::move(tx);
-    m_backsem_sync = std::make_shared<std::counting_semaphore<detail::coroutine_queue_capacity + 1>>(
-        detail::coroutine_queue_capacity);
+    m_max_searching = builder.m_max_searching_workers;
+    if (m_max_searching == 0) {
+        m_max_searching = std::min<std::size_t>(2, (nthreads + 1) / 2);
+    }
+
+    // 协程帧之前是 join 状态，按返回 void 的任务估算
+    m_task_capacity = builder.m_task_capacity;
+    detail::task_capacity capacity{
+        m_task_capacity, builder.m_frame_size_hint + join_handle<void>::frame_offset};
 
     auto [idtx, idrx] = detail::idle_workers_create();
     m_idle_workers_rx = std::move(idrx);
@@ -43,14 +58,35 @@ runtime::runtime(runtime_builder &&builder)
         m_workers.push_back(
             std::make_unique<worker>(
                 i,                                //
-                rx,                               //
-                m_backsem_sync,                   //
+                m_injection_queue,                //
                 &m_workers_local_runtime_ptr[i],  // 曾经的 runtime
                                                   // 可以被移动，这是为了支持移动留下的参数，移动现已被禁用
                 this,                             //
-                idtx));
+                idtx,                             //
+                builder.m_scheduler_factory,      //
+                capacity));
         *m_workers_local_runtime_ptr[i] = this;
     }
+    m_workers_started.store(true, std::memory_order::release);
+
+    m_blocking_pool =
+        std::make_unique<blocking_pool>(builder.m_blocking_threads, builder.m_blocking_keep_alive, this);
+}
+
+runtime::~runtime() {
+    // 停止 execution 迁移，并等待正在进行的投递完成，之后收件箱中的 execution 都会被目标 worker 接收
+    m_stopping.store(true, std::memory_order::seq_cst);
+    while (m_donating.load(std::memory_order::seq_cst)) {
+        std::this_thread::yield();
+    }
+    // 阻塞任务可能正在等待 worker 上的任务，先停止阻塞线程池；线程池保持可用，停止期间的 spawn_blocking 仍能提交
+    m_blocking_pool->shutdown();
+    // 先停止所有 worker 再逐个析构，避免仍在运行的 worker 偷取已析构 worker 的本地队列
+    for (auto &w : m_workers) {
+        w->join();
+    }
+    // worker 停止前可能又提交了阻塞任务
+    m_blocking_pool->shutdown();
 }
 
 runtime &runtime::current() {
@@ -72,9 +108,146 @@ os::io_adapter &runtime::get_io_adapter() {
     return *m_io_adapter;
 }
 
-void runtime::awake_next() noexcept {
-    if (auto id = m_idle_workers_rx.try_recv()) {
-        m_workers[*id]->awake();
+runtime::park_stats runtime::get_park_stats() const noexcept {
+    park_stats res{
+        0, m_unparks.load(std::memory_order::relaxed), m_skipped_wakes.load(std::memory_order::relaxed), 0,
+        m_migrations.load(std::memory_order::relaxed)};
+    for (auto &w : m_workers) {
+        res.parks += w->m_parks.load(std::memory_order::relaxed);
+        res.spin_hits += w->m_spin_hits.load(std::memory_order::relaxed);
+    }
+    return res;
+}
+
+runtime::task_capacity_stats runtime::get_task_capacity_stats() const {
+    task_capacity_stats res{m_task_capacity, 0, 0};
+    auto report = mm::coroutine_pool::occupancy_report();
+    for (auto &w : m_workers) {
+        res.record_overflows += w->m_execution_domain.reserve_overflows();
+        auto tid = w->m_dthread.get_id();
+        for (auto &o : report) {
+            if (o.thread == tid) {
+                for (auto &c : o.classes) {
+                    res.frame_overflows += c.overflows;
+                }
+            }
+        }
+    }
+    return res;
+}
+
+void runtime::awake_next() noexcept { awake_n(1); }
+
+void runtime::submit(detail::coroutine_meta &&meta, bool pending_reserved) {
+    if (!pending_reserved && m_max_pending_tasks != std::numeric_limits<std::size_t>::max()) {
+        m_pending_tasks.fetch_add(1, std::memory_order::acq_rel);
+    }
+
+    if (auto w = worker::_current_worker; w && w->m_runtime_ptr == this) {
+        w->m_local_queue.push(std::move(meta));
+        // 唤醒一个空闲 worker 来偷取本地队列中的任务
+        awake_next();
+        return;
+    }
+
+    m_injection_queue.push(std::move(meta));
+    awake_next();
+}
+
+void runtime::submit_batch(std::vector<detail::coroutine_meta> &metas) {
+    if (metas.empty()) {
+        return;
+    }
+
+    if (m_max_pending_tasks != std::numeric_limits<std::size_t>::max()) {
+        m_pending_tasks.fetch_add(metas.size(), std::memory_order::acq_rel);
+    }
+
+    if (auto w = worker::_current_worker; w && w->m_runtime_ptr == this) {
+        w->m_local_queue.push_batch(metas);
+        // 当前 worker 自己会处理其中一个任务，其余的交给被唤醒的空闲 worker 偷取
+        awake_n(metas.size() - 1);
+        return;
+    }
+
+    m_injection_queue.push_batch(metas);
+    awake_n(metas.size());
+}
+
+void runtime::awake_n(std::size_t n) noexcept {
+    if (!n) {
+        return;
+    }
+
+    // 与 worker::park 及搜索者退出后的复查配对：任务已经发布，要么这里看到搜索者/空闲 worker，
+    // 要么它们在休眠前看到新任务
+    std::atomic_thread_fence(std::memory_order::seq_cst);
+    // 正在搜索的 worker 很快会取走任务，不必再唤醒休眠的 worker
+    if (auto searching = m_searching.load(std::memory_order::relaxed)) {
+        auto skipped = std::min(searching, n);
+        m_skipped_wakes.fetch_add(skipped, std::memory_order::relaxed);
+        n -= skipped;
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        if (auto id = m_idle_workers_rx.try_recv()) {
+            m_unparks.fetch_add(1, std::memory_order::relaxed);
+            auto &w = *m_workers[*id];
+            w.m_idle_listed.store(false, std::memory_order::release);
+            w.awake();
+        } else {
+            break;
+        }
+    }
+}
+
+bool runtime::try_begin_search() noexcept {
+    auto n = m_searching.load(std::memory_order::relaxed);
+    while (n < m_max_searching) {
+        if (m_searching.compare_exchange_weak(
+                n, n + 1, std::memory_order::seq_cst, std::memory_order::relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool runtime::end_search() noexcept {
+    auto last = m_searching.fetch_sub(1, std::memory_order::seq_cst) == 1;
+    std::atomic_thread_fence(std::memory_order::seq_cst);
+    return last;
+}
+
+bool runtime::has_visible_work() const noexcept {
+    if (!m_injection_queue.empty()) {
+        return true;
+    }
+    if (!m_workers_started.load(std::memory_order::acquire)) {
+        return false;
+    }
+    return std::ranges::any_of(m_workers, [](auto &w) { return w->m_local_queue.size() != 0; });
+}
+
+bool runtime::try_reserve_pending() noexcept {
+    if (m_max_pending_tasks == std::numeric_limits<std::size_t>::max()) {
+        return true;
+    }
+    auto n = m_pending_tasks.load(std::memory_order::relaxed);
+    while (n < m_max_pending_tasks) {
+        if (m_pending_tasks.compare_exchange_weak(
+                n, n + 1, std::memory_order::acq_rel, std::memory_order::relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void runtime::on_task_attached() noexcept {
+    if (m_max_pending_tasks == std::numeric_limits<std::size_t>::max()) {
+        return;
+    }
+    if (m_pending_tasks.fetch_sub(1, std::memory_order::acq_rel) <= m_max_pending_tasks) {
+        m_pending_cv.notify_one();
     }
 }
 
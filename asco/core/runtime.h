@@ -3,26 +3,34 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <concepts>
 #include <coroutine>
 #include <cstddef>
 #include <functional>
+#include <limits>
 #include <memory>
-#include <semaphore>
+#include <ranges>
 #include <type_traits>
 #include <utility>
 #include <variant>
 #include <vector>
 
 #include <asco/concurrency/hash_map.h>
+#include <asco/core/blocking_pool.h>
 #include <asco/core/os/io.h>
+#include <asco/core/task/dynprio_scheduler.h>
+#include <asco/core/task/mlfq_scheduler.h>
 #include <asco/core/time/high_resolution_timer.h>
 #include <asco/core/time/timer.h>
 #include <asco/core/worker.h>
 #include <asco/future.h>
 #include <asco/invoke.h>
+#include <asco/join_group.h>
 #include <asco/join_handle.h>
 #include <asco/panic.h>
+#include <asco/sync/condition_variable.h>
 #include <asco/util/safe_erased.h>
 #include <asco/util/types.h>
 
@@ -55,6 +63,57 @@ public:
 
     runtime_builder &&enable_all() && { return std::move(*this).with_timer().with_io(); }
 
+    // 尚未被 worker 取走的任务数量达到 n 时视为 runtime 饱和，此时 spawn_async 会挂起等待
+    // spawn 不受此限制，永远不会阻塞
+    runtime_builder &&with_max_pending_tasks(std::size_t n) && {
+        m_max_pending_tasks = n;
+        return std::move(*this);
+    }
+
+    // 阻塞线程池的线程数上限
+    runtime_builder &&with_blocking_threads(std::size_t max) && {
+        m_blocking_threads = max;
+        return std::move(*this);
+    }
+
+    // 阻塞线程空闲超过这段时间后退出
+    runtime_builder &&with_blocking_keep_alive(std::chrono::nanoseconds keep_alive) && {
+        m_blocking_keep_alive = keep_alive;
+        return std::move(*this);
+    }
+
+    // 同时处于自旋搜索阶段的 worker 数量上限，0 表示按 worker 数量自动选择（最多 2 个）
+    runtime_builder &&with_max_searching_workers(std::size_t n) && {
+        m_max_searching_workers = n;
+        return std::move(*this);
+    }
+
+    // coroutine_pool 的 block 与大容量队列的存储改为映射 2 MiB 大页，降低大量任务时的 dTLB 缺失
+    // 系统没有预留大页时退化为透明大页；只对该 runtime 的 worker 线程与构建期间分配的队列生效，
+    // 其它线程（包括 blocking_pool 的线程）上的分配不受影响
+    runtime_builder &&with_huge_pages(bool enabled = true) && {
+        m_huge_pages = enabled;
+        return std::move(*this);
+    }
+
+    // 构建时在每个 worker 上为 n 个并发任务预留协程帧与 join 状态、execution 记录、任务元数据与调度状态，
+    // frame_size_hint 为典型的协程帧大小；超出预留时仍能分配，次数可通过 get_task_capacity_stats 查看
+    runtime_builder &&with_task_capacity(std::size_t n, std::size_t frame_size_hint = 512) && {
+        m_task_capacity = n;
+        m_frame_size_hint = frame_size_hint;
+        return std::move(*this);
+    }
+
+    // 选择 worker 的顶层调度器，默认为 task::dynprio_scheduler
+    template<std::derived_from<task::scheduler> Scheduler>
+        requires std::default_initializable<Scheduler>
+    runtime_builder &&with_scheduler() && {
+        m_scheduler_factory = []() -> std::unique_ptr<task::scheduler> {
+            return std::make_unique<Scheduler>();
+        };
+        return std::move(*this);
+    }
+
     runtime build() &&;
 
 private:
@@ -64,14 +123,25 @@ private:
     std::size_t m_nthreads{0};
     std::unique_ptr<time::timer> m_timer{nullptr};
     std::unique_ptr<os::io_adapter> m_io_adapter{nullptr};
+    std::size_t m_max_pending_tasks{std::numeric_limits<std::size_t>::max()};
+    std::size_t m_blocking_threads{512};
+    std::chrono::nanoseconds m_blocking_keep_alive{std::chrono::seconds{10}};
+    std::size_t m_max_searching_workers{0};
+    bool m_huge_pages{false};
+    std::size_t m_task_capacity{0};
+    std::size_t m_frame_size_hint{0};
+    detail::scheduler_factory m_scheduler_factory{
+        []() -> std::unique_ptr<task::scheduler> { return std::make_unique<task::dynprio_scheduler>(); }};
 };
 
 class runtime final {
     friend class worker;
+    friend class blocking_pool;
     friend bool asco::in_runtime() noexcept;
 
 public:
     explicit runtime(runtime_builder &&builder);
+    ~runtime();
 
     runtime(const runtime &) = delete;
     runtime &operator=(const runtime &) = delete;
@@ -84,6 +154,25 @@ public:
     time::timer &get_timer();
     os::io_adapter &get_io_adapter();
 
+    struct park_stats {
+        std::size_t parks;          // worker 进入休眠的次数
+        std::size_t unparks;        // 从空闲队列中取出并唤醒 worker 的次数
+        std::size_t skipped_wakes;  // 因已有 worker 在搜索任务而省略的唤醒次数
+        std::size_t spin_hits;      // worker 在自旋阶段找到任务、免于休眠的次数
+        std::size_t migrations;     // 活动的 execution 从繁忙 worker 迁移到休眠 worker 的次数
+    };
+
+    park_stats get_park_stats() const noexcept;
+
+    struct task_capacity_stats {
+        std::size_t capacity;          // 每个 worker 预留的并发任务数
+        std::size_t frame_overflows;   // 预留的协程帧用尽后仍需分配的次数
+        std::size_t record_overflows;  // 预留的 execution 记录与调度状态用尽后仍需新建的次数
+    };
+
+    // 任意一项不为 0 说明 with_task_capacity 的预留不足
+    task_capacity_stats get_task_capacity_stats() const;
+
     template<typename TaskLocalStorage>
     auto block_on(async_function<> auto &&fn, TaskLocalStorage &&task_local_storage) {
         asco_assert(this_task::is_blocking_env());
@@ -99,11 +188,9 @@ public:
             tls = util::safe_erased::of_void();
         }
 
-        m_backsem_sync->acquire();
-        m_coroutine_tx.try_send(
+        submit(
             {jh.m_state->this_handle, &jh.m_state->cancel_awake_token,
-             &jh.m_state->__cancel_awake_token_storage, &jh.get_cancel_source(), std::move(tls), false});
-        awake_next();
+             &jh.m_state->__cancel_awake_token_storage, &jh.get_cancel_source(), std::move(tls)});
         if constexpr (std::is_void_v<return_type>) {
             jh.await();
             return;
@@ -118,41 +205,72 @@ public:
 
     template<typename TaskLocalStorage>
     auto spawn(async_function<> auto &&fn, TaskLocalStorage &&task_local_storage) {
-        using output_type = std::invoke_result_t<decltype(fn)>::output_type;
+        return spawn_submit<TaskLocalStorage>(
+            std::forward<decltype(fn)>(fn), std::forward<TaskLocalStorage>(task_local_storage), false);
+    }
 
-        auto jh = spawn_impl<TaskLocalStorage>(std::forward<decltype(fn)>(fn));
-        util::safe_erased tls;
-        if constexpr (!std::is_void_v<TaskLocalStorage>) {
-            tls = jh.initialize_task_local_storage(
-                std::forward<decltype(task_local_storage)>(task_local_storage));
-        } else {
-            tls = util::safe_erased::of_void();
-        }
+    auto spawn(async_function<> auto &&fn) { return spawn(std::forward<decltype(fn)>(fn), std::monostate{}); }
 
-        if (in_runtime()) {
-            if (!m_backsem_sync->try_acquire()) {
-                worker::current().fetch_task();
-            }
-        } else {
-            m_backsem_sync->acquire();
-        }
-        m_coroutine_tx.try_send(
-            {jh.m_state->this_handle, &jh.m_state->cancel_awake_token,
-             &jh.m_state->__cancel_awake_token_storage, &jh.get_cancel_source(), std::move(tls), false});
-        awake_next();
+    // runtime 饱和时挂起当前任务而不是阻塞线程，直到占到空位后再 spawn
+    // 空位在等待条件中原子地占用，同时被唤醒的多个等待者不会超出 max_pending_tasks
+    template<typename TaskLocalStorage>
+    auto spawn_async(async_function<> auto fn, TaskLocalStorage task_local_storage) -> future<join_handle<
+        typename std::invoke_result_t<decltype(fn)>::output_type,
+        util::types::void_if_monostate<TaskLocalStorage>>> {
+        co_await m_pending_cv.wait([this] { return try_reserve_pending(); });
+        co_return spawn_submit<TaskLocalStorage>(std::move(fn), std::move(task_local_storage), true);
+    }
 
-        return jh;
+    auto spawn_async(async_function<> auto fn) { return spawn_async(std::move(fn), std::monostate{}); }
+
+    bool saturated() const noexcept {
+        return m_pending_tasks.load(std::memory_order::acquire) >= m_max_pending_tasks;
     }
 
-    auto spawn(async_function<> auto &&fn) { return spawn(std::forward<decltype(fn)>(fn), std::monostate{}); }
+    // 一次提交一组异步函数：所有任务在同一批次中发布，并只唤醒足以覆盖这一批任务的空闲 worker
+    template<std::ranges::input_range Range>
+        requires(std::ranges::sized_range<Range> && async_function<std::ranges::range_reference_t<Range>>)
+    auto spawn_many(Range &&range) {
+        using fn_type = std::remove_cvref_t<std::ranges::range_reference_t<Range>>;
+        using output_type = std::invoke_result_t<fn_type &>::output_type;
+
+        auto n = static_cast<std::size_t>(std::ranges::size(range));
+        join_group<output_type> group{n};
+        auto &state = group.m_state;
+
+        std::vector<detail::coroutine_meta> metas;
+        metas.reserve(n);
+        std::size_t i = 0;
+        for (auto &&fn : range) {
+            auto &slot = state->slots[i];
+            // 右值 range 的元素可以移动进任务，左值 range 的元素需要复制
+            auto task = [&] {
+                if constexpr (std::is_lvalue_reference_v<Range>) {
+                    return join_group<output_type>::template run_one<fn_type>(state, i, fn);
+                } else {
+                    return join_group<output_type>::template run_one<fn_type>(state, i, std::move(fn));
+                }
+            }();
+            metas.push_back(
+                {task.handle, &slot.cancel_awake_token, &slot.__cancel_awake_token_storage,
+                 &state->cancel_source, util::safe_erased::of_void()});
+            ++i;
+        }
+        asco_assert(i == n);
+
+        submit_batch(metas);
+        return group;
+    }
 
     template<typename TaskLocalStorage>
     auto spawn_blocking(std::invocable<> auto &&fn, TaskLocalStorage &&task_local_storage)
         requires(!async_function<decltype(fn)>)
     {
         using output_type = std::invoke_result_t<decltype(fn)>;
+        using handle_type = join_handle<output_type, util::types::void_if_monostate<TaskLocalStorage>>;
 
-        auto jh = spawn_blocking_impl<TaskLocalStorage>(std::forward<decltype(fn)>(fn));
+        // 阻塞闭包交给专用的阻塞线程池运行，不经过 worker
+        auto jh = handle_type::create_blocking();
         util::safe_erased tls;
         if constexpr (!std::is_void_v<TaskLocalStorage>) {
             tls = jh.initialize_task_local_storage(
@@ -161,17 +279,12 @@ public:
             tls = util::safe_erased::of_void();
         }
 
-        if (in_runtime()) {
-            if (!m_backsem_sync->try_acquire()) {
-                worker::current().fetch_task();
-            }
-        } else {
-            m_backsem_sync->acquire();
-        }
-        m_coroutine_tx.try_send(
-            {jh.m_state->this_handle, &jh.m_state->cancel_awake_token,
-             &jh.m_state->__cancel_awake_token_storage, &jh.get_cancel_source(), std::move(tls), true});
-        awake_next();
+        m_blocking_pool->submit(
+            blocking_pool::job::create(
+                [state = jh.m_state, fn = std::forward<decltype(fn)>(fn)]() mutable noexcept {
+                    handle_type::run_blocking(*state, fn);
+                },
+                std::move(tls), jh.get_cancel_source().get_token()));
 
         return jh;
     }
@@ -184,6 +297,46 @@ public:
 
 private:
     void awake_next() noexcept;
+    // 最多唤醒 n 个空闲 worker
+    void awake_n(std::size_t n) noexcept;
+
+    // 搜索者名额：成功占用名额时返回 true
+    bool try_begin_search() noexcept;
+    // 释放名额，返回释放后是否已没有搜索者
+    bool end_search() noexcept;
+    // 全局队列或任一 worker 的本地队列中是否有尚未附加的任务（近似）
+    bool has_visible_work() const noexcept;
+
+    // 在本 runtime 的 worker 上 spawn 时放入该 worker 的本地队列，否则放入全局注入队列
+    // pending_reserved 为 true 时调用方已通过 try_reserve_pending 占用了空位
+    void submit(detail::coroutine_meta &&meta, bool pending_reserved = false);
+    void submit_batch(std::vector<detail::coroutine_meta> &metas);
+    // worker 将一个任务附加到执行域后调用
+    void on_task_attached() noexcept;
+    // 未饱和时原子地占用一个空位，由 spawn_async 在等待条件中调用
+    bool try_reserve_pending() noexcept;
+
+    template<typename TaskLocalStorage>
+    auto spawn_submit(
+        async_function<> auto &&fn, TaskLocalStorage &&task_local_storage, bool pending_reserved) {
+        using output_type = std::invoke_result_t<decltype(fn)>::output_type;
+
+        auto jh = spawn_impl<TaskLocalStorage>(std::forward<decltype(fn)>(fn));
+        util::safe_erased tls;
+        if constexpr (!std::is_void_v<TaskLocalStorage>) {
+            tls = jh.initialize_task_local_storage(
+                std::forward<decltype(task_local_storage)>(task_local_storage));
+        } else {
+            tls = util::safe_erased::of_void();
+        }
+
+        submit(
+            {jh.m_state->this_handle, &jh.m_state->cancel_awake_token,
+             &jh.m_state->__cancel_awake_token_storage, &jh.get_cancel_source(), std::move(tls)},
+            pending_reserved);
+
+        return jh;
+    }
 
     template<typename TaskLocalStorage>
     auto spawn_impl(async_function<> auto fn) -> join_handle<
@@ -199,27 +352,36 @@ private:
         }
     }
 
-    template<typename TaskLocalStorage>
-    auto spawn_blocking_impl(std::invocable<> auto fn)
-        -> join_handle<std::invoke_result_t<decltype(fn)>, util::types::void_if_monostate<TaskLocalStorage>> {
-        using output_type = std::invoke_result_t<decltype(fn)>;
-        if constexpr (std::is_void_v<output_type>) {
-            std::invoke(fn);
-            co_return;
-        } else {
-            co_return std::invoke(fn);
-        }
-    }
-
     detail::idle_workers_receiver m_idle_workers_rx;
 
-    detail::coroutine_sender m_coroutine_tx;
-    std::shared_ptr<std::counting_semaphore<detail::coroutine_queue_capacity + 1>> m_backsem_sync;
+    detail::injection_queue m_injection_queue;
+
+    const std::size_t m_max_pending_tasks;
+    std::atomic_size_t m_pending_tasks{0};
+    sync::condition_variable m_pending_cv;
 
     std::unique_ptr<time::timer> m_timer;
     std::unique_ptr<os::io_adapter> m_io_adapter;
+    const bool m_huge_pages;
 
     std::vector<std::unique_ptr<worker>> m_workers;
+    std::size_t m_task_capacity{0};
+    // 所有 worker 构造完成后置位，此后 worker 才能遍历 m_workers 进行任务偷窃
+    std::atomic_bool m_workers_started{false};
+
+    std::size_t m_max_searching{1};
+    std::atomic_size_t m_searching{0};
+    std::atomic_size_t m_unparks{0};
+    std::atomic_size_t m_skipped_wakes{0};
+    std::atomic_size_t m_parked{0};
+
+    // execution 迁移
+    std::atomic_uint64_t m_migration_serial{0};
+    std::atomic_size_t m_migrations{0};
+    std::atomic_size_t m_donating{0};
+    std::atomic_bool m_stopping{false};
+
+    std::unique_ptr<blocking_pool> m_blocking_pool;
     std::vector<runtime **> m_workers_local_runtime_ptr;
 
     inline static concurrency::hash_map<std::coroutine_handle<>, worker *> m_corohandle_worker_map;
@@ -237,6 +399,22 @@ auto spawn(async_function<> auto &&fn, TaskLocalStorage &&task_local_storage) {
 
 auto spawn(async_function<> auto &&fn) { return spawn(std::forward<decltype(fn)>(fn), std::monostate{}); }
 
+template<std::ranges::input_range Range>
+    requires(std::ranges::sized_range<Range> && async_function<std::ranges::range_reference_t<Range>>)
+auto spawn_many(Range &&range) {
+    return core::runtime::current().spawn_many(std::forward<Range>(range));
+}
+
+template<typename TaskLocalStorage>
+auto spawn_async(async_function<> auto &&fn, TaskLocalStorage &&task_local_storage) {
+    return core::runtime::current().spawn_async(
+        std::forward<decltype(fn)>(fn), std::forward<decltype(task_local_storage)>(task_local_storage));
+}
+
+auto spawn_async(async_function<> auto &&fn) {
+    return spawn_async(std::forward<decltype(fn)>(fn), std::monostate{});
+}
+
 template<typename TaskLocalStorage>
 auto spawn_blocking(std::invocable<> auto &&fn, TaskLocalStorage &&task_local_storage)
     requires(!async_function<decltype(fn)>)
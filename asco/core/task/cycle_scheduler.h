@@ -4,9 +4,9 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <tuple>
-#include <utility>
 
 #include <asco/core/task/execution_domain.h>
 #include <asco/core/task/scheduler.h>
@@ -33,9 +33,9 @@ class cycle_scheduler : public scheduler {
             if ((state.suspend_now && !state.preawaken) || completed) {
                 state.active = false;
                 m_scheduler->m_active_count--;
-                m_scheduler->m_domain->suspend_execution(state.id);
+                m_scheduler->m_domain->suspend_execution(*state.exec);
             } else {
-                m_scheduler->m_domain->activate_execution(state.id);
+                m_scheduler->m_domain->activate_execution(*state.exec);
             }
             state.suspend_now = false;
         }
@@ -45,8 +45,9 @@ class cycle_scheduler : public scheduler {
         std::size_t m_execution_index;
     };
 
+    // 挂在 execution::scheduler_entry 上的调度状态
     struct execution_sched {
-        execution_id id{};
+        execution *exec{nullptr};
         bool active{true};
         cycle_context ctx{nullptr, {}};
 
@@ -57,80 +58,69 @@ class cycle_scheduler : public scheduler {
     };
 
 public:
-    void attach_execution(execution_id id) override {
+    void attach_execution(execution &exec) override {
         asco_assert(m_fill_index < N);
 
         m_executions[m_fill_index] =
-            execution_sched{id, true, cycle_context{this, m_fill_index}, false, false};
-        m_execution_index_map[m_fill_index] = {id, m_fill_index};
+            execution_sched{&exec, true, cycle_context{this, m_fill_index}, false, false};
+        exec.scheduler_entry.store(&m_executions[m_fill_index], std::memory_order::release);
         ++m_active_count;
         ++m_fill_index;
     }
 
-    void detach_suspended_execution(execution_id id) override {
-        for (auto &p : m_execution_index_map) {
-            if (p.first == id) {
-                auto &state = m_executions[p.second];
-                asco_assert(!state.active);
-                state.detached = true;
-                state.id = execution_id{};
-                m_detached_count++;
-                break;
-            }
-        }
+    bool detach_execution(execution &exec) override {
+        auto state = state_of(exec);
+        exec.scheduler_entry.store(nullptr, std::memory_order::release);
+        asco_assert(state && !state->active);
+        state->detached = true;
+        state->exec = nullptr;
+        m_detached_count++;
+        return state->preawaken;
     }
 
-    void awake_execution(execution_id id) noexcept override {
-        for (auto &p : m_execution_index_map) {
-            if (p.first == id) {
-                auto &state = m_executions[p.second];
-                if (!state.active) {
-                    state.suspend_now = false;
-                    state.active = true;
-                    m_active_count++;
-                    m_domain->activate_execution(id);
-                } else {
-                    state.preawaken = true;
-                }
-                break;
+    void awake_execution(execution &exec) noexcept override {
+        if (auto state = state_of(exec)) {
+            if (!state->active) {
+                state->suspend_now = false;
+                state->active = true;
+                m_active_count++;
+                m_domain->activate_execution(exec);
+            } else {
+                state->preawaken = true;
             }
         }
 
-        auto parent_domain = m_domain->get_parent_domain();
-        auto parent_exec = m_domain->get_parent_execution();
-        if (parent_domain && parent_domain->get_execution_state(parent_exec) == execution_state::suspended) {
-            parent_domain->get_scheduler().awake_execution(parent_exec);
-        }
+        awake_parent();
     }
 
-    void suspend_current(execution_id id) noexcept override {
-        for (auto &p : m_execution_index_map) {
-            if (p.first == id) {
-                auto &state = m_executions[p.second];
-                if (state.preawaken) {
-                    state.preawaken = false;
-                    break;
-                }
-                state.suspend_now = true;
-                m_domain->suspend_execution(id);
-                break;
+    void suspend_current(execution &exec) noexcept override {
+        if (auto state = state_of(exec)) {
+            if (state->preawaken) {
+                state->preawaken = false;
+                return;
             }
+            state->suspend_now = true;
+            m_domain->suspend_execution(exec);
         }
     }
 
-    std::tuple<execution_id, context &> schedule() override {
+    std::tuple<execution &, context &> schedule() override {
         while (m_executions[m_current_execution_index % N].detached
                || !m_executions[m_current_execution_index % N].active) {
             m_current_execution_index++;
         }
         auto index = m_current_execution_index++ % N;
-        return {m_executions[index].id, m_executions[index].ctx};
+        return {*m_executions[index].exec, m_executions[index].ctx};
     }
 
     bool has_active_execution() override { return m_active_count > 0; }
     bool has_suspended_execution() override { return N - m_active_count - m_detached_count > 0; }
 
 private:
+    static execution_sched *state_of(execution &exec) noexcept {
+        return static_cast<execution_sched *>(exec.scheduler_entry.load(std::memory_order::acquire));
+    }
+
     std::size_t m_current_execution_index{0};
 
     std::array<execution_sched, N> m_executions;
@@ -138,8 +128,6 @@ private:
 
     std::size_t m_active_count{0};
     std::size_t m_detached_count{0};
-
-    std::array<std::pair<execution_id, std::size_t>, N> m_execution_index_map;
 };
 
 };  // namespace asco::core::task
@@ -3,91 +3,126 @@
 
 #include <asco/core/task/dynprio_scheduler.h>
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <queue>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include <asco/panic.h>
 #include <asco/util/tsc.h>
 
 namespace asco::core::task {
 
-dynprio_scheduler::dynprio_context &
-dynprio_scheduler::dynprio_context::operator=(dynprio_context &&rhs) noexcept {
-    if (this != &rhs) {
-        m_scheduler = rhs.m_scheduler;
-        m_id = rhs.m_id;
-        m_begin = rhs.m_begin;
-    }
-    return *this;
-}
-
 void dynprio_scheduler::dynprio_context::begin() noexcept { m_begin = util::get_tsc(); }
 
 void dynprio_scheduler::dynprio_context::end(bool completed) noexcept {
     auto end = util::get_tsc();
     auto exec_time = end - m_begin;
-    if ((m_scheduler->m_current_suspend && !m_scheduler->m_preawake_executions.remove(m_id)) || completed) {
-        m_scheduler->m_suspended_executions.insert(m_id);
-        m_scheduler->m_domain->suspend_execution(m_id);
+    auto &s = *m_scheduler;
+    auto &e = *m_entry;
+
+    auto requeue = [&] {
+        e.priority += exec_time;
+        e.state.store(entry_state::active, std::memory_order::release);
+        s.m_domain->activate_execution(*e.exec);
+        s.m_active_executions.lock()->push(prioritied_execution{&e, e.priority});
+    };
+
+    if (completed) {
+        e.state.store(entry_state::finished, std::memory_order::release);
+        s.m_domain->suspend_execution(*e.exec);
+    } else if (s.m_current_suspend) {
+        // CAS 成功后其它线程随时可能唤醒该 entry ，计数与执行域状态必须在发布 suspended 之前更新
+        s.m_suspended.fetch_add(1, std::memory_order::relaxed);
+        s.m_domain->suspend_execution(*e.exec);
+        auto st = entry_state::running;
+        if (!e.state.compare_exchange_strong(
+                st, entry_state::suspended, std::memory_order::acq_rel, std::memory_order::acquire)) {
+            // 挂起前已被唤醒
+            s.m_suspended.fetch_sub(1, std::memory_order::relaxed);
+            requeue();
+        }
     } else {
-        m_scheduler->m_suspended_executions.remove(m_id);
-        m_scheduler->m_active_executions.lock()->push(
-            prioritied_execution{m_id, m_scheduler->m_current_execution.priority + exec_time});
-        m_scheduler->m_domain->activate_execution(m_id);
+        requeue();
     }
-    m_scheduler->m_current_suspend = false;
+    s.m_current = nullptr;
+    s.m_current_suspend = false;
 }
 
-void dynprio_scheduler::attach_execution(execution_id id) {
-    asco_assert(m_exec_ctx_map.insert(id, dynprio_context{this, id}));
-    m_active_executions.lock()->push(prioritied_execution{id, 0});
+void dynprio_scheduler::attach_execution(execution &exec) {
+    auto e = allocate_entry();
+    e->exec = &exec;
+    e->state.store(entry_state::active, std::memory_order::relaxed);
+    e->priority = 0;
+    exec.scheduler_entry.store(e, std::memory_order::release);
+    m_active_executions.lock()->push(prioritied_execution{e, 0});
 }
 
-void dynprio_scheduler::detach_suspended_execution(execution_id id) {
-    if (m_suspended_executions.remove(id)) {
-        m_exec_ctx_map.remove(id);
+bool dynprio_scheduler::detach_execution(execution &exec) {
+    // execution 已从执行域移除，不会再有唤醒方访问该 entry
+    auto e = static_cast<entry *>(exec.scheduler_entry.exchange(nullptr, std::memory_order::acq_rel));
+    asco_assert(e);
+    auto st = e->state.load(std::memory_order::acquire);
+    if (st == entry_state::suspended) {
+        m_suspended.fetch_sub(1, std::memory_order::relaxed);
     }
+    recycle_entry(e);
+    return st == entry_state::running_preawaken;
 }
 
-void dynprio_scheduler::awake_execution(execution_id id) noexcept {
-    if (!m_exec_ctx_map.contains(id)) {
-        return;
-    }
-    
-    if (m_suspended_executions.remove(id)) {
-        m_active_executions.lock()->push({id, 0});
-        m_domain->activate_execution(id);
-    } else {
-        m_preawake_executions.insert(id);
-    }
-    auto parent_domain = m_domain->get_parent_domain();
-    auto parent_exec = m_domain->get_parent_execution();
-    if (parent_domain && parent_domain->get_execution_state(parent_exec) == execution_state::suspended) {
-        parent_domain->get_scheduler().awake_execution(parent_exec);
+void dynprio_scheduler::awake_execution(execution &exec) noexcept {
+    if (auto e = static_cast<entry *>(exec.scheduler_entry.load(std::memory_order::acquire))) {
+        auto st = e->state.load(std::memory_order::acquire);
+        while (true) {
+            if (st == entry_state::suspended) {
+                if (e->state.compare_exchange_weak(
+                        st, entry_state::active, std::memory_order::acq_rel, std::memory_order::acquire)) {
+                    m_suspended.fetch_sub(1, std::memory_order::relaxed);
+                    e->priority = 0;
+                    m_domain->activate_execution(exec);
+                    m_active_executions.lock()->push(prioritied_execution{e, 0});
+                    break;
+                }
+            } else if (st == entry_state::running) {
+                if (e->state.compare_exchange_weak(
+                        st, entry_state::running_preawaken, std::memory_order::acq_rel,
+                        std::memory_order::acquire)) {
+                    break;
+                }
+            } else {
+                break;
+            }
+        }
     }
+
+    awake_parent();
 }
 
-void dynprio_scheduler::suspend_current(execution_id id) noexcept {
-    asco_assert(m_current_execution.id == id);
-    if (!m_exec_ctx_map.contains(id)) {
-        return;
-    }
+void dynprio_scheduler::suspend_current(execution &exec) noexcept {
+    asco_assert(m_current && m_current->exec == &exec);
 
-    if (m_preawake_executions.remove(id)) {
+    auto st = entry_state::running_preawaken;
+    if (m_current->state.compare_exchange_strong(
+            st, entry_state::running, std::memory_order::acq_rel, std::memory_order::acquire)) {
         return;
     }
 
-    m_domain->suspend_execution(id);
+    m_domain->suspend_execution(exec);
     m_current_suspend = true;
 }
 
-std::tuple<execution_id, dynprio_scheduler::context &> dynprio_scheduler::schedule() {
+std::tuple<execution &, dynprio_scheduler::context &> dynprio_scheduler::schedule() {
     auto g = m_active_executions.lock();
     asco_assert(!g->empty());
 
-    m_current_execution = g->top();
+    m_current = g->top().e;
     g->pop();
+    m_current->state.store(entry_state::running, std::memory_order::release);
 
-    return {m_current_execution.id, m_exec_ctx_map.get(m_current_execution.id).value()};
+    return {*m_current->exec, m_current->ctx};
 }
 
 bool dynprio_scheduler::has_active_execution() {
@@ -96,7 +131,50 @@ bool dynprio_scheduler::has_active_execution() {
 }
 
 bool dynprio_scheduler::has_suspended_execution() {
-    return m_suspended_executions.size() || m_current_suspend;
+    return m_suspended.load(std::memory_order::relaxed) || m_current_suspend;
+}
+
+execution *dynprio_scheduler::detach_active_execution() {
+    auto g = m_active_executions.lock();
+    // 带有子执行域的 execution 不能迁移，此时本轮放弃
+    if (g->size() < 2 || g->top().e->exec->subdomain) {
+        return nullptr;
+    }
+    auto e = g->top().e;
+    g->pop();
+    return e->exec;
+}
+
+void dynprio_scheduler::reserve(std::size_t n) {
+    m_entries.reserve(m_entries.size() + n);
+    m_free_entries.reserve(m_entries.capacity());
+    for (std::size_t i = 0; i < n; ++i) {
+        m_free_entries.push_back(m_entries.emplace_back(std::make_unique<entry>(this)).get());
+    }
+
+    // 用预留了容量的 vector 重建活动队列
+    auto g = m_active_executions.lock();
+    std::vector<prioritied_execution> storage;
+    storage.reserve(g->size() + n);
+    while (!g->empty()) {
+        storage.push_back(g->top());
+        g->pop();
+    }
+    *g = std::priority_queue<prioritied_execution, std::vector<prioritied_execution>>{{}, std::move(storage)};
+}
+
+dynprio_scheduler::entry *dynprio_scheduler::allocate_entry() {
+    if (m_free_entries.empty()) {
+        return m_entries.emplace_back(std::make_unique<entry>(this)).get();
+    }
+    auto e = m_free_entries.back();
+    m_free_entries.pop_back();
+    return e;
+}
+
+void dynprio_scheduler::recycle_entry(entry *e) {
+    e->exec = nullptr;
+    m_free_entries.push_back(e);
 }
 
 };  // namespace asco::core::task
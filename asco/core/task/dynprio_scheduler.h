@@ -3,70 +3,95 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <deque>
+#include <memory>
 #include <queue>
 #include <tuple>
+#include <vector>
 
-#include <asco/concurrency/hash_map.h>
 #include <asco/core/task/execution_domain.h>
 #include <asco/core/task/scheduler.h>
-#include <asco/sync/spinlock.h>
+#include <asco/sync/mcs_spinlock.h>
 
 namespace asco::core::task {
 
 class dynprio_scheduler final : public scheduler {
+    enum class entry_state : std::uint8_t {
+        active,             // 在活动队列中
+        running,            // 正在运行
+        running_preawaken,  // 正在运行，且在挂起前已被唤醒
+        suspended,          // 已挂起
+        finished,           // 已结束，唤醒不再生效
+    };
+
+    struct entry;
+
     class dynprio_context final : public context {
     public:
-        dynprio_context(dynprio_scheduler *scheduler, execution_id id)
+        dynprio_context(dynprio_scheduler *scheduler, entry *e)
                 : m_scheduler{scheduler}
-                , m_id{id} {}
-
-        dynprio_context(dynprio_context &&rhs) noexcept
-                : m_scheduler{rhs.m_scheduler}
-                , m_id{rhs.m_id}
-                , m_begin{rhs.m_begin} {}
-
-        dynprio_context &operator=(dynprio_context &&rhs) noexcept;
+                , m_entry{e} {}
 
         void begin() noexcept override;
         void end(bool completed) noexcept override;
 
     private:
         dynprio_scheduler *m_scheduler;
-        execution_id m_id;
-        std::uint64_t m_begin;
+        entry *m_entry;
+        std::uint64_t m_begin{0};
+    };
+
+    // 挂在 execution::scheduler_entry 上的调度状态
+    struct entry {
+        explicit entry(dynprio_scheduler *scheduler)
+                : ctx{scheduler, this} {}
+
+        execution *exec{nullptr};
+        std::atomic<entry_state> state{entry_state::active};
+        std::uint64_t priority{0};
+
+        dynprio_context ctx;
     };
 
     struct prioritied_execution {
-        execution_id id;
+        entry *e;
         std::uint64_t priority;
 
         bool operator<(const prioritied_execution &rhs) const { return priority > rhs.priority; }
     };
 
 public:
-    void attach_execution(execution_id id) override;
-    void detach_suspended_execution(execution_id id) override;
+    void attach_execution(execution &exec) override;
+    bool detach_execution(execution &exec) override;
 
-    void awake_execution(execution_id id) noexcept override;
-    void suspend_current(execution_id id) noexcept override;
+    void awake_execution(execution &exec) noexcept override;
+    void suspend_current(execution &exec) noexcept override;
 
-    std::tuple<execution_id, context &> schedule() override;
+    std::tuple<execution &, context &> schedule() override;
 
     bool has_active_execution() override;
     bool has_suspended_execution() override;
 
+    execution *detach_active_execution() override;
+
+    void reserve(std::size_t n) override;
+
 private:
-    prioritied_execution m_current_execution;
+    entry *allocate_entry();
+    void recycle_entry(entry *e);
+
+    entry *m_current{nullptr};
     bool m_current_suspend{false};
 
-    sync::spinlock<std::priority_queue<prioritied_execution, std::deque<prioritied_execution>>>
+    sync::mcs_spinlock<std::priority_queue<prioritied_execution, std::vector<prioritied_execution>>>
         m_active_executions;
-    concurrency::hash_set<execution_id> m_suspended_executions;
-    concurrency::hash_set<execution_id> m_preawake_executions;
+    std::atomic_size_t m_suspended{0};
 
-    concurrency::hash_map<execution_id, dynprio_context> m_exec_ctx_map;
+    // 只由所属 worker 访问
+    std::vector<std::unique_ptr<entry>> m_entries;  // 持有全部 entry，entry 只回收不释放
+    std::vector<entry *> m_free_entries;
 };
 
 };  // namespace asco::core::task
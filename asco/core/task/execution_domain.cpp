@@ -6,9 +6,11 @@
 #include <algorithm>
 #include <atomic>
 #include <coroutine>
+#include <memory>
 #include <span>
 #include <utility>
 
+#include <asco/core/task/scheduler.h>
 #include <asco/panic.h>
 
 namespace asco::core::task {
@@ -21,92 +23,129 @@ execution::execution(execution_id id)
 
 execution::~execution() {}
 
-execution::execution(execution &&rhs) noexcept
-        : id{rhs.id}
-        , handle_stack{std::move(rhs.handle_stack)}
-        , cancel_src_stack{}
-        , subdomain{rhs.subdomain}
-        , cancel_src_stack_size{rhs.cancel_src_stack_size}
-        , state{rhs.state.load(std::memory_order_acquire)} {
-    std::ranges::copy(rhs.cancel_src_stack, cancel_src_stack);
+void execution::reset(execution_id new_id) noexcept {
+    id = new_id;
+    handle_stack.clear();
+    handle_stack.push_back(new_id);
+    std::ranges::fill(cancel_src_stack, nullptr);
+    subdomain = nullptr;
+    cancel_src_stack_size = 0;
+    std::ranges::fill(cancel_token_stack, cancel_token{});
+    cancel_callback_stack.clear();
+    state.store(execution_state::active, std::memory_order::relaxed);
+    scheduler_entry.store(nullptr, std::memory_order::relaxed);
+    task_meta = nullptr;
+    prev_in_domain = next_in_domain = nullptr;
 }
 
-execution &execution::operator=(execution &&rhs) noexcept {
-    if (this != &rhs) {
-        this->~execution();
-        new (this) execution(std::move(rhs));
+execution &execution_domain::attach_execution(
+    execution_id id, const std::span<cancel_source *> &parent_srcstack, cancel_source *cancel_src) {
+    asco_assert(parent_srcstack.size() < util::compile_config::core::task::execution_domain_nest_max_depth);
+
+    std::unique_ptr<execution> exec;
+    if (!m_spare_records.empty()) {
+        exec = std::move(m_spare_records.back());
+        m_spare_records.pop_back();
+        exec->reset(id);
+    } else {
+        if (m_spare_records.capacity()) {
+            m_reserve_overflows.fetch_add(1, std::memory_order::relaxed);
+        }
+        exec = std::make_unique<execution>(id);
     }
-    return *this;
+    std::ranges::copy(parent_srcstack, exec->cancel_src_stack);
+    exec->cancel_src_stack[parent_srcstack.size()] = cancel_src;
+    exec->cancel_src_stack[parent_srcstack.size() + 1] = nullptr;
+    exec->cancel_src_stack_size = parent_srcstack.size() + 1;
+    std::ranges::transform(exec->get_cancel_source_stack(), exec->cancel_token_stack, [](cancel_source *src) {
+        return src->get_token();
+    });
+    return adopt_execution(std::move(exec));
 }
 
-void execution_domain::attach_execution(
-    execution_id id, const std::span<cancel_source *> &parent_srcstack, cancel_source *cancel_src) {
-    asco_assert(parent_srcstack.size() < util::compile_config::core::task::execution_domain_nest_max_depth);
+std::unique_ptr<execution> execution_domain::detach_execution(execution_id id) {
+    // remove 会等待其它线程持有的 guard 释放
+    auto exec = m_executions.remove(id);
+    asco_assert(exec);
+    unlink(**exec);
+    return std::move(*exec);
+}
 
-    execution exec{id};
-    std::ranges::copy(parent_srcstack, exec.cancel_src_stack);
-    exec.cancel_src_stack[parent_srcstack.size()] = cancel_src;
-    exec.cancel_src_stack[parent_srcstack.size() + 1] = nullptr;
-    exec.cancel_src_stack_size = parent_srcstack.size() + 1;
-    m_executions.insert(id, std::move(exec));
-    m_corohandle_exec_map.insert(id, execution_id{id});
-    m_execution_list.insert(id);
+void execution_domain::recycle_execution(std::unique_ptr<execution> exec) noexcept {
+    // 空位已满时直接释放，不让 vector 扩容
+    if (m_spare_records.size() < m_spare_records.capacity()) {
+        exec->cancel_callback_stack.clear();
+        m_spare_records.push_back(std::move(exec));
+    }
 }
 
-void execution_domain::detach_execution(execution_id id) {
-    m_executions.remove(id);
-    m_corohandle_exec_map.remove(id);
-    m_execution_list.erase(id);
+void execution_domain::reserve(std::size_t n) {
+    m_executions.reserve(m_executions.size() + n);
+    m_spare_records.reserve(m_spare_records.capacity() + n);
+    refill_spare_records();
 }
 
-scheduled_execution execution_domain::schedule_execution(execution_id id) {
-    auto g = m_executions.get(id);
-    asco_assert(g);
-    g.value().state.store(execution_state::running, std::memory_order::release);
-    return {*this, id, &g.value()};
+void execution_domain::refill_spare_records() {
+    while (m_spare_records.size() < m_spare_records.capacity()) {
+        m_spare_records.push_back(std::make_unique<execution>(execution_id{}));
+    }
 }
 
-void execution_domain::suspend_execution(execution_id id) {
-    auto g = m_executions.get(id);
-    asco_assert(g);
-    g.value().state.store(execution_state::suspended, std::memory_order::release);
+std::unique_ptr<execution> execution_domain::take_execution(execution_id id) {
+    auto exec = detach_execution(id);
+    asco_assert(!exec->subdomain);
+    return exec;
 }
 
-void execution_domain::activate_execution(execution_id id) {
-    auto g = m_executions.get(id);
-    asco_assert(g);
-    g.value().state.store(execution_state::active, std::memory_order::release);
+execution &execution_domain::adopt_execution(std::unique_ptr<execution> exec) {
+    auto &ref = *exec;
+    link(ref);
+    asco_assert(m_executions.insert(ref.id, std::move(exec)));
+    return ref;
 }
 
 void execution_domain::activate_all() {
-    for (auto id : m_execution_list) {
-        activate_execution(id);
+    for (auto exec = m_execution_list; exec; exec = exec->next_in_domain) {
+        activate_execution(*exec);
     }
 }
 
-execution_state execution_domain::get_execution_state(execution_id id) {
-    auto g = m_executions.get(id);
-    asco_assert(g);
-    return g.value().state.load(std::memory_order::acquire);
+void execution_domain::awake_execution(execution_id id) noexcept {
+    if (auto g = m_executions.get(id)) {
+        m_scheduler.awake_execution(*g.value());
+    }
 }
 
 std::coroutine_handle<> execution_domain::top_of_execution(execution_id id) {
     if (auto g = m_executions.get(id)) {
-        if (g.value().handle_stack.empty()) {
+        if (g.value()->handle_stack.empty()) {
             return {};
         }
-        return g.value().handle_stack.back();
+        return g.value()->handle_stack.back();
     } else {
         panic("execution_domain::top_of_execution: id {{{}}} 不存在", id.address());
     }
 }
 
-execution_id execution_domain::execution_of_coroutine(std::coroutine_handle<> handle) {
-    if (auto g = m_corohandle_exec_map.get(handle)) {
-        return g.value();
+void execution_domain::link(execution &exec) noexcept {
+    exec.prev_in_domain = nullptr;
+    exec.next_in_domain = m_execution_list;
+    if (m_execution_list) {
+        m_execution_list->prev_in_domain = &exec;
+    }
+    m_execution_list = &exec;
+}
+
+void execution_domain::unlink(execution &exec) noexcept {
+    if (exec.prev_in_domain) {
+        exec.prev_in_domain->next_in_domain = exec.next_in_domain;
     } else {
-        panic("execution_domain::execution_of_coroutine: 协程 {{{}}} 不存在于任何执行流中", handle.address());
+        m_execution_list = exec.next_in_domain;
+    }
+    if (exec.next_in_domain) {
+        exec.next_in_domain->prev_in_domain = exec.prev_in_domain;
     }
+    exec.prev_in_domain = exec.next_in_domain = nullptr;
 }
 
 };  // namespace asco::core::task
@@ -7,8 +7,8 @@
 #include <cstddef>
 #include <coroutine>
 #include <functional>
+#include <memory>
 #include <span>
-#include <unordered_set>
 #include <vector>
 
 #include <asco/concurrency/hash_map.h>
@@ -30,7 +30,7 @@ enum class execution_state {
 };
 
 struct execution {
-    const execution_id id;
+    execution_id id;  // 只在记录被回收复用时改变
     std::vector<std::coroutine_handle<>> handle_stack;
     cancel_source *cancel_src_stack[util::compile_config::core::task::execution_domain_nest_max_depth + 1]{
         nullptr};
@@ -38,24 +38,41 @@ struct execution {
                                   // 此指针为非 nullptr 时， executor 直接进入 subdomain 调度
 
     std::size_t cancel_src_stack_size{0};
+    // 与 cancel_src_stack 一一对应的 token，在附加时取得一次，恢复执行时不再重建
+    cancel_token cancel_token_stack[util::compile_config::core::task::execution_domain_nest_max_depth + 1]{};
 
     std::vector<std::function<void()>> cancel_callback_stack{};
     std::atomic<execution_state> state{execution_state::active};
 
+    // 侵入式状态：热路径上通过 execution 记录直接找到，不经过任何哈希查找
+    std::atomic<void *> scheduler_entry{nullptr};  // 所属调度器为该 execution 保存的私有状态
+    void *task_meta{nullptr};  // worker 附加的任务元数据，子执行域中的 execution 继承父 execution 的值
+
+    // 执行域内 execution 的侵入式链表，只由执行域所属的 worker 访问
+    execution *prev_in_domain{nullptr};
+    execution *next_in_domain{nullptr};
+
     execution(execution_id id);
     ~execution();
 
     execution(const execution &) = delete;
     execution &operator=(const execution &) = delete;
 
-    execution(execution &&rhs) noexcept;
-    execution &operator=(execution &&rhs) noexcept;
+    // 记录在整个生命周期中地址不变，调度器与执行器持有指向它的指针
+    execution(execution &&) = delete;
+    execution &operator=(execution &&) = delete;
 
     void remove_subdomain() noexcept { subdomain = nullptr; }
 
+    // 复用回收的记录：恢复到刚构造时的状态，保留各个栈已分配的容量
+    void reset(execution_id new_id) noexcept;
+
     std::span<cancel_source *> get_cancel_source_stack() {
         return std::span{cancel_src_stack, cancel_src_stack_size};
     }
+    std::span<cancel_token> get_cancel_token_stack() {
+        return std::span{cancel_token_stack, cancel_src_stack_size};
+    }
 };
 
 struct scheduled_execution {
@@ -67,11 +84,6 @@ struct scheduled_execution {
 };
 
 class execution_domain final {
-    friend class executor;
-    friend class execution_domain_proxy;
-    friend class asco::core::cancel_source;
-    friend class asco::core::cancel_callback;
-
 public:
     explicit execution_domain(scheduler &sched)
             : m_scheduler{sched} {}
@@ -85,38 +97,70 @@ public:
     void set_parent_domain(execution_domain &parent) { m_parent_domain = &parent; }
     execution_domain *get_parent_domain() const { return m_parent_domain; }
 
-    void set_parent_execution(execution_id id) { m_parent_execution_id = id; }
-    execution_id get_parent_execution() const { return m_parent_execution_id; }
+    // 父 execution 的记录在子执行域存续期间一直有效（子执行域位于父 execution 的协程帧中）
+    void set_parent_execution(execution &exec) { m_parent_execution = &exec; }
+    execution *get_parent_execution() const { return m_parent_execution; }
 
-    void attach_execution(
+    // 返回的记录地址在 execution 从本执行域移除之前保持不变
+    execution &attach_execution(
         execution_id id, const std::span<cancel_source *> &parent_srcstack, cancel_source *cancel_src);
-    void detach_execution(execution_id id);
+    // 移出 execution 的记录，返回时其它线程上的 awake_execution 已不再访问它
+    std::unique_ptr<execution> detach_execution(execution_id id);
+    // 交还已结束的 execution 的记录，预留的空位未满时留待下次 attach_execution 复用
+    void recycle_execution(std::unique_ptr<execution> exec) noexcept;
+
+    // 为 n 个并发 execution 预先创建记录并扩容索引，之后 attach_execution 优先复用这些记录
+    void reserve(std::size_t n);
+    // 把空位补足到预留的数量，记录随 execution 迁出后调用
+    void refill_spare_records();
+    // 预留的记录用尽后仍需新建记录的次数
+    std::size_t reserve_overflows() const noexcept {
+        return m_reserve_overflows.load(std::memory_order::relaxed);
+    }
 
-    scheduled_execution schedule_execution(execution_id id);
-    void suspend_execution(execution_id id);
-    void activate_execution(execution_id id);
+    // 把 execution 的记录连同其协程栈整体移出本执行域，用于迁移到其它 worker
+    // 带有子执行域的 execution 不能迁移，调用方需事先排除
+    std::unique_ptr<execution> take_execution(execution_id id);
+    // 接收由 take_execution 移出的 execution
+    execution &adopt_execution(std::unique_ptr<execution> exec);
+
+    scheduled_execution schedule_execution(execution &exec) {
+        exec.state.store(execution_state::running, std::memory_order::release);
+        return {*this, exec.id, &exec};
+    }
+    void suspend_execution(execution &exec) {
+        exec.state.store(execution_state::suspended, std::memory_order::release);
+    }
+    void activate_execution(execution &exec) {
+        exec.state.store(execution_state::active, std::memory_order::release);
+    }
 
     void activate_all();
 
-    execution_state get_execution_state(execution_id id);
+    // 由其它线程唤醒 execution：这是唯一需要按 id 查找记录的路径，记录在唤醒期间不会被移除
+    void awake_execution(execution_id id) noexcept;
 
     std::coroutine_handle<> top_of_execution(execution_id id);
-    execution_id execution_of_coroutine(std::coroutine_handle<> handle);
 
     bool is_empty() const { return !m_executions.size(); }
 
     scheduler &get_scheduler() const { return m_scheduler; }
 
 private:
+    void link(execution &exec) noexcept;
+    void unlink(execution &exec) noexcept;
+
     execution_domain *m_parent_domain{nullptr};
-    execution_id m_parent_execution_id{};
+    execution *m_parent_execution{nullptr};
 
     scheduler &m_scheduler;
 
-    std::unordered_set<execution_id>
-        m_execution_list;  // TODO 暂时方案，未来给 concurrency::hash_map 添加迭代器后移除
-    concurrency::hash_map<execution_id, execution> m_executions;
-    concurrency::hash_map<std::coroutine_handle<>, execution_id> m_corohandle_exec_map;
+    execution *m_execution_list{nullptr};
+    concurrency::hash_map<execution_id, std::unique_ptr<execution>> m_executions;
+
+    // 只由执行域所属的 worker 访问，容量即预留的记录数量
+    std::vector<std::unique_ptr<execution>> m_spare_records;
+    std::atomic_size_t m_reserve_overflows{0};
 };
 
 };  // namespace asco::core::task
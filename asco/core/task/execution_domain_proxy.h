@@ -17,10 +17,9 @@ public:
             : m_domain{sched} {
         sched.bind_execution_domain(m_domain);
         auto &w = worker::current();
-        auto exec = w.get_executor().current_execution();
-        auto &current_domain = w.get_current_execution_domain();
-        current_domain.m_executions.get(exec).value().subdomain = &m_domain;
-        m_domain.set_parent_domain(current_domain);
+        auto &exec = *w.get_executor().current_execution_record();
+        exec.subdomain = &m_domain;
+        m_domain.set_parent_domain(w.get_current_execution_domain());
         m_domain.set_parent_execution(exec);
     }
 
@@ -28,9 +27,11 @@ public:
 
     void attach_execution(execution_id id) {
         auto &w = core::worker::current();
-        auto cancel_src = w.get_executor().current_cancel_source_stack();
-        m_domain.attach_execution(id, cancel_src, &m_cancel_src);
-        m_domain.get_scheduler().attach_execution(id);
+        auto &parent = *w.get_executor().current_execution_record();
+        auto &exec = m_domain.attach_execution(id, parent.get_cancel_source_stack(), &m_cancel_src);
+        // 子执行域中的 execution 共享父任务的任务局部存储
+        exec.task_meta = parent.task_meta;
+        m_domain.get_scheduler().attach_execution(exec);
     }
 
     execution_domain &get_domain() { return m_domain; }
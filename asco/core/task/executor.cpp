@@ -6,13 +6,13 @@
 #include <algorithm>
 #include <coroutine>
 #include <ranges>
-#include <vector>
+#include <span>
 
 #include <asco/panic.h>
 
 namespace asco::core::task {
 
-bool executor::execute(scheduled_execution exec, const std::vector<scheduler_context *> &ctxs) {
+bool executor::execute(scheduled_execution exec, std::span<scheduler_context *const> ctxs) {
     m_domain = &exec.m_domain;
     m_current_id = exec.m_id;
     m_execution = exec.m_exec;
@@ -23,10 +23,8 @@ bool executor::execute(scheduled_execution exec, const std::vector<scheduler_con
         return false;
     }
 
-    m_current_cancel_token_stack =
-        m_execution->get_cancel_source_stack()
-        | std::views::transform([](cancel_source *src) { return src->get_token(); })
-        | std::ranges::to<std::vector<cancel_token>>();
+    m_current_cancel_token_stack = m_execution->get_cancel_token_stack();
+    m_transfer_budget = direct_transfer_budget;
 
     std::ranges::for_each(ctxs, [](scheduler_context *ctx) { ctx->begin(); });
     auto exit_stack = [&](bool completed) {
@@ -36,6 +34,7 @@ bool executor::execute(scheduled_execution exec, const std::vector<scheduler_con
         });
         m_domain = nullptr;
         m_execution = nullptr;
+        m_current_cancel_token_stack = {};
     };
 
     if (cancel_cleanup()) {
@@ -56,8 +55,6 @@ bool executor::execute(scheduled_execution exec, const std::vector<scheduler_con
 void executor::push_handle(std::coroutine_handle<> handle) {
     asco_assert(m_execution);
     m_execution->handle_stack.push_back(handle);
-    asco_assert(m_domain);
-    m_domain->m_corohandle_exec_map.insert(handle, std::coroutine_handle{m_execution->handle_stack.front()});
 }
 
 std::coroutine_handle<> executor::pop_handle() {
@@ -67,8 +64,6 @@ std::coroutine_handle<> executor::pop_handle() {
     }
     auto hdl = m_execution->handle_stack.back();
     m_execution->handle_stack.pop_back();
-    asco_assert(m_domain);
-    m_domain->m_corohandle_exec_map.remove(hdl);
     return hdl;
 }
 
@@ -90,9 +85,21 @@ bool executor::is_base_coroutine(std::coroutine_handle<> handle) const {
     return m_execution && m_execution->handle_stack.size() && m_execution->handle_stack.front() == handle;
 }
 
+bool executor::try_direct_transfer() noexcept {
+    if (!m_execution || !m_transfer_budget || cancel_requested()) {
+        return false;
+    }
+    --m_transfer_budget;
+    return true;
+}
+
+bool executor::cancel_requested() noexcept {
+    return std::ranges::any_of(
+        m_current_cancel_token_stack, [](cancel_token &token) { return token.cancel_requested(); });
+}
+
 bool executor::cancel_cleanup() noexcept {
-    if (std::ranges::all_of(
-            m_current_cancel_token_stack, [](cancel_token &token) { return !token.cancel_requested(); })) {
+    if (!cancel_requested()) {
         return false;
     }
 
@@ -4,8 +4,8 @@
 #pragma once
 
 #include <coroutine>
+#include <cstddef>
 #include <span>
-#include <vector>
 
 #include <asco/core/cancellation.h>
 #include <asco/core/task/execution_domain.h>
@@ -29,26 +29,36 @@ public:
     executor &operator=(executor &&) = delete;
 
     // 返回 false 表示当前执行流已结束
-    bool execute(scheduled_execution exec, const std::vector<scheduler_context *> &ctxs);
+    bool execute(scheduled_execution exec, std::span<scheduler_context *const> ctxs);
 
     void push_handle(std::coroutine_handle<> handle);
     std::coroutine_handle<> pop_handle();
 
     std::coroutine_handle<> current_coroutine() const;
     execution_id current_execution() const;
+    // 当前 execution 的记录，没有正在运行的 execution 时为 nullptr
+    execution *current_execution_record() const noexcept { return m_execution; }
     bool is_base_coroutine(std::coroutine_handle<> handle) const;
 
+    // 协程间对称转移前调用：返回 false 时应挂起回到 worker
+    // 连续转移次数超出预算或当前执行流被请求取消时，回到 worker 以保证调度公平性与取消检查
+    bool try_direct_transfer() noexcept;
+
     std::span<cancel_source *> current_cancel_source_stack() const {
         return m_execution ? m_execution->get_cancel_source_stack() : std::span<cancel_source *>{};
     }
-    std::vector<cancel_token> &get_cancel_token_stack() { return m_current_cancel_token_stack; }
+    std::span<cancel_token> get_cancel_token_stack() const { return m_current_cancel_token_stack; }
 
 private:
     execution_domain *m_domain{nullptr};
     execution_id m_current_id{};
     execution *m_execution{nullptr};
-    std::vector<cancel_token> m_current_cancel_token_stack;
+    std::span<cancel_token> m_current_cancel_token_stack;  // 指向当前 execution 记录中缓存的 token
+
+    static constexpr std::size_t direct_transfer_budget = 128;
+    std::size_t m_transfer_budget{0};
 
+    bool cancel_requested() noexcept;
     bool cancel_cleanup() noexcept;
 };
 
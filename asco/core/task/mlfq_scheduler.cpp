@@ -0,0 +1,275 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <asco/core/task/mlfq_scheduler.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include <asco/panic.h>
+#include <asco/util/tsc.h>
+
+namespace asco::core::task {
+
+void mlfq_scheduler::mlfq_context::begin() noexcept { m_begin = util::get_tsc(); }
+
+void mlfq_scheduler::mlfq_context::end(bool completed) noexcept {
+    auto &s = *m_scheduler;
+    auto &e = *m_entry;
+
+    if (e.epoch != s.m_epoch) {
+        e.epoch = s.m_epoch;
+        e.level = 0;
+        e.slice_used = 0;
+    }
+    e.slice_used += util::get_tsc() - m_begin;
+    if (e.slice_used >= (base_quantum << e.level)) {
+        e.level = std::min(e.level + 1, levels - 1);
+        e.slice_used = 0;
+    }
+
+    if (completed) {
+        e.state.store(entry_state::finished, std::memory_order::release);
+        s.m_domain->suspend_execution(*e.exec);
+    } else if (s.m_current_suspend) {
+        // CAS 成功后其它线程随时可能唤醒该 entry ，计数与执行域状态必须在发布 suspended 之前更新
+        s.m_suspended.fetch_add(1, std::memory_order::relaxed);
+        s.m_domain->suspend_execution(*e.exec);
+        auto st = entry_state::running;
+        if (!e.state.compare_exchange_strong(
+                st, entry_state::suspended, std::memory_order::acq_rel, std::memory_order::acquire)) {
+            // 挂起前已被唤醒
+            s.m_suspended.fetch_sub(1, std::memory_order::relaxed);
+            e.state.store(entry_state::queued, std::memory_order::release);
+            s.enqueue(&e);
+            s.m_domain->activate_execution(*e.exec);
+        }
+    } else {
+        e.state.store(entry_state::queued, std::memory_order::release);
+        s.enqueue(&e);
+        s.m_domain->activate_execution(*e.exec);
+    }
+
+    s.m_current = nullptr;
+    s.m_current_suspend = false;
+}
+
+void mlfq_scheduler::attach_execution(execution &exec) {
+    auto e = allocate_entry();
+    e->exec = &exec;
+    e->state.store(entry_state::queued, std::memory_order::relaxed);
+    e->level = 0;
+    e->slice_used = 0;
+    e->epoch = m_epoch;
+    exec.scheduler_entry.store(e, std::memory_order::release);
+    enqueue(e);
+}
+
+bool mlfq_scheduler::detach_execution(execution &exec) {
+    // execution 已从执行域移除，不会再有唤醒方访问该 entry
+    auto e = static_cast<entry *>(exec.scheduler_entry.exchange(nullptr, std::memory_order::acq_rel));
+    asco_assert(e);
+    auto st = e->state.load(std::memory_order::acquire);
+    if (st == entry_state::suspended) {
+        m_suspended.fetch_sub(1, std::memory_order::relaxed);
+    }
+    recycle_entry(e);
+    return st == entry_state::running_preawaken;
+}
+
+void mlfq_scheduler::awake_execution(execution &exec) noexcept {
+    if (auto e = static_cast<entry *>(exec.scheduler_entry.load(std::memory_order::acquire))) {
+        auto st = e->state.load(std::memory_order::acquire);
+        while (true) {
+            if (st == entry_state::suspended) {
+                if (e->state.compare_exchange_weak(
+                        st, entry_state::queued, std::memory_order::acq_rel, std::memory_order::acquire)) {
+                    m_suspended.fetch_sub(1, std::memory_order::relaxed);
+                    m_domain->activate_execution(exec);
+                    push_inbox(e);
+                    break;
+                }
+            } else if (st == entry_state::running) {
+                if (e->state.compare_exchange_weak(
+                        st, entry_state::running_preawaken, std::memory_order::acq_rel,
+                        std::memory_order::acquire)) {
+                    break;
+                }
+            } else {
+                // 已在队列中、已预唤醒或已结束，唤醒不需要再做任何事
+                break;
+            }
+        }
+    }
+
+    awake_parent();
+}
+
+void mlfq_scheduler::suspend_current(execution &exec) noexcept {
+    asco_assert(m_current && m_current->exec == &exec);
+
+    auto st = entry_state::running_preawaken;
+    if (m_current->state.compare_exchange_strong(
+            st, entry_state::running, std::memory_order::acq_rel, std::memory_order::acquire)) {
+        return;
+    }
+
+    m_domain->suspend_execution(exec);
+    m_current_suspend = true;
+}
+
+std::tuple<execution &, mlfq_scheduler::context &> mlfq_scheduler::schedule() {
+    drain_inbox();
+    if (++m_schedule_tick % aging_period == 0) {
+        age();
+    }
+
+    auto e = dequeue();
+    asco_assert(e);
+    e->state.store(entry_state::running, std::memory_order::release);
+    m_current = e;
+    return {*e->exec, e->ctx};
+}
+
+bool mlfq_scheduler::has_active_execution() {
+    drain_inbox();
+    return m_ready_mask != 0;
+}
+
+bool mlfq_scheduler::has_suspended_execution() {
+    return m_suspended.load(std::memory_order::relaxed) || m_current_suspend;
+}
+
+execution *mlfq_scheduler::detach_active_execution() {
+    drain_inbox();
+    if (m_queued < 2) {
+        return nullptr;
+    }
+
+    // 带有子执行域的 execution 不能迁移，此时本轮放弃
+    auto level = static_cast<std::size_t>(std::countr_zero(m_ready_mask));
+    if (m_queues[level].head->exec->subdomain) {
+        return nullptr;
+    }
+
+    // 出队后仍保持 queued 状态，此后到达的唤醒不做任何事
+    return dequeue()->exec;
+}
+
+void mlfq_scheduler::enqueue(entry *e) noexcept {
+    if (e->epoch != m_epoch) {
+        e->epoch = m_epoch;
+        e->level = 0;
+        e->slice_used = 0;
+    }
+
+    auto &q = m_queues[e->level];
+    e->next = nullptr;
+    if (q.tail) {
+        q.tail->next = e;
+    } else {
+        q.head = e;
+    }
+    q.tail = e;
+    m_ready_mask |= 1u << e->level;
+    ++m_queued;
+}
+
+mlfq_scheduler::entry *mlfq_scheduler::dequeue() noexcept {
+    if (!m_ready_mask) {
+        return nullptr;
+    }
+
+    auto level = static_cast<std::size_t>(std::countr_zero(m_ready_mask));
+    auto &q = m_queues[level];
+    auto e = q.head;
+    q.head = e->next;
+    if (!q.head) {
+        q.tail = nullptr;
+        m_ready_mask &= ~(1u << level);
+    }
+    e->next = nullptr;
+    --m_queued;
+    return e;
+}
+
+void mlfq_scheduler::push_inbox(entry *e) noexcept {
+    auto head = m_inbox.load(std::memory_order::relaxed);
+    do {
+        e->next_wake = head;
+    } while (!m_inbox.compare_exchange_weak(
+        head, e, std::memory_order::release, std::memory_order::relaxed));
+}
+
+void mlfq_scheduler::drain_inbox() noexcept {
+    if (!m_inbox.load(std::memory_order::relaxed)) {
+        return;
+    }
+
+    // 收件箱是后进先出的栈，反转后按唤醒顺序入队
+    auto e = m_inbox.exchange(nullptr, std::memory_order::acquire);
+    entry *reversed{nullptr};
+    while (e) {
+        auto next = e->next_wake;
+        e->next_wake = reversed;
+        reversed = e;
+        e = next;
+    }
+    while (reversed) {
+        auto next = reversed->next_wake;
+        reversed->next_wake = nullptr;
+        enqueue(reversed);
+        reversed = next;
+    }
+}
+
+void mlfq_scheduler::age() noexcept {
+    // 把各级队列按级别顺序拼接到最高级，条目中的级别在下次入队或运行结束时按 epoch 惰性重置
+    ++m_epoch;
+    auto &top = m_queues[0];
+    for (std::size_t i = 1; i < levels; ++i) {
+        auto &q = m_queues[i];
+        if (!q.head) {
+            continue;
+        }
+        if (top.tail) {
+            top.tail->next = q.head;
+        } else {
+            top.head = q.head;
+        }
+        top.tail = q.tail;
+        q.head = q.tail = nullptr;
+    }
+    m_ready_mask = top.head ? 1u : 0u;
+}
+
+void mlfq_scheduler::reserve(std::size_t n) {
+    m_entries.reserve(m_entries.size() + n);
+    m_free_entries.reserve(m_entries.capacity());
+    for (std::size_t i = 0; i < n; ++i) {
+        m_free_entries.push_back(m_entries.emplace_back(std::make_unique<entry>(this)).get());
+    }
+}
+
+mlfq_scheduler::entry *mlfq_scheduler::allocate_entry() {
+    if (m_free_entries.empty()) {
+        return m_entries.emplace_back(std::make_unique<entry>(this)).get();
+    }
+    auto e = m_free_entries.back();
+    m_free_entries.pop_back();
+    return e;
+}
+
+void mlfq_scheduler::recycle_entry(entry *e) {
+    e->exec = nullptr;
+    e->next = nullptr;
+    e->next_wake = nullptr;
+    m_free_entries.push_back(e);
+}
+
+};  // namespace asco::core::task
@@ -0,0 +1,124 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <asco/core/task/execution_domain.h>
+#include <asco/core/task/scheduler.h>
+
+namespace asco::core::task {
+
+// 多级反馈队列调度器
+// 每一级是一条侵入式先进先出链表，入队与出队均为 O(1)；用位图找到最高的非空级别
+// 一次运行耗尽本级时间片的 execution 降一级，每调度 aging_period 次把所有 execution 提升回最高级
+// 其它线程的唤醒只修改 execution 的原子状态并压入无锁收件箱，由所属 worker 在调度时取出
+// 每个 execution 的调度状态挂在 execution::scheduler_entry 上，调度路径不做任何哈希查找
+class mlfq_scheduler final : public scheduler {
+public:
+    static constexpr std::size_t levels = 8;
+    // 最高级的时间片（TSC 周期数），每降一级翻倍
+    static constexpr std::uint64_t base_quantum = 100'000;
+    static constexpr std::size_t aging_period = 1024;
+
+private:
+    enum class entry_state : std::uint8_t {
+        queued,              // 在运行队列或收件箱中
+        running,             // 正在运行
+        running_preawaken,   // 正在运行，且在挂起前已被唤醒
+        suspended,           // 已挂起
+        finished,            // 已结束或正在被移除，唤醒不再生效
+    };
+
+    struct entry;
+
+    class mlfq_context final : public context {
+    public:
+        mlfq_context(mlfq_scheduler *scheduler, entry *e)
+                : m_scheduler{scheduler}
+                , m_entry{e} {}
+
+        void begin() noexcept override;
+        void end(bool completed) noexcept override;
+
+    private:
+        mlfq_scheduler *m_scheduler;
+        entry *m_entry;
+        std::uint64_t m_begin{0};
+    };
+
+    struct entry {
+        explicit entry(mlfq_scheduler *scheduler)
+                : ctx{scheduler, this} {}
+
+        execution *exec{nullptr};
+        std::atomic<entry_state> state{entry_state::queued};
+        std::size_t level{0};
+        std::uint64_t slice_used{0};
+        std::uint64_t epoch{0};
+
+        entry *next{nullptr};       // 运行队列链表，只由所属 worker 访问
+        entry *next_wake{nullptr};  // 收件箱链表
+
+        mlfq_context ctx;
+    };
+
+    struct run_queue {
+        entry *head{nullptr};
+        entry *tail{nullptr};
+    };
+
+public:
+    mlfq_scheduler() = default;
+
+    mlfq_scheduler(const mlfq_scheduler &) = delete;
+    mlfq_scheduler &operator=(const mlfq_scheduler &) = delete;
+
+    void attach_execution(execution &exec) override;
+    bool detach_execution(execution &exec) override;
+
+    void awake_execution(execution &exec) noexcept override;
+    void suspend_current(execution &exec) noexcept override;
+
+    std::tuple<execution &, context &> schedule() override;
+
+    bool has_active_execution() override;
+    bool has_suspended_execution() override;
+
+    execution *detach_active_execution() override;
+
+    void reserve(std::size_t n) override;
+
+private:
+    void enqueue(entry *e) noexcept;
+    entry *dequeue() noexcept;
+    void push_inbox(entry *e) noexcept;
+    void drain_inbox() noexcept;
+    void age() noexcept;
+
+    entry *allocate_entry();
+    void recycle_entry(entry *e);
+
+    // 以下成员只由所属 worker 访问
+    std::array<run_queue, levels> m_queues{};
+    std::uint32_t m_ready_mask{0};
+    std::size_t m_queued{0};
+    std::uint64_t m_epoch{0};
+    std::size_t m_schedule_tick{0};
+    entry *m_current{nullptr};
+    bool m_current_suspend{false};
+    std::vector<std::unique_ptr<entry>> m_entries;  // 持有全部 entry，entry 只回收不释放
+    std::vector<entry *> m_free_entries;
+
+    std::atomic<entry *> m_inbox{nullptr};
+    std::atomic_size_t m_suspended{0};
+};
+
+};  // namespace asco::core::task
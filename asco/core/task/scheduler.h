@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <tuple>
 
 #include <asco/core/task/execution_domain.h>
@@ -16,6 +18,8 @@ protected:
     using context = scheduler_context;
 
 public:
+    virtual ~scheduler() = default;
+
     void bind_execution_domain(execution_domain &domain) {
         if (m_domain) {
             panic("asco::core::task::scheduler: 已绑定执行域");
@@ -30,19 +34,40 @@ public:
         return *m_domain;
     }
 
-    virtual void attach_execution(execution_id id) = 0;
-    virtual void detach_suspended_execution(execution_id id) = 0;
+    // 调度器把自己的私有状态挂在 execution::scheduler_entry 上，之后的调度都通过记录直接访问
+    virtual void attach_execution(execution &exec) = 0;
+    // execution 已从执行域移除、不会再被唤醒时调用，释放调度器的私有状态
+    // 返回 execution 是否带有预唤醒标记
+    virtual bool detach_execution(execution &exec) = 0;
 
     // `**强制性语义要求**`: 唤醒时要同时唤醒父 execution_domain 中的父 execution
-    virtual void awake_execution(execution_id id) noexcept = 0;
-    virtual void suspend_current(execution_id id) noexcept = 0;
+    // 可能在其它线程上调用，调用方保证期间记录不会被移除
+    virtual void awake_execution(execution &exec) noexcept = 0;
+    virtual void suspend_current(execution &exec) noexcept = 0;
 
-    virtual std::tuple<execution_id, context &> schedule() = 0;
+    virtual std::tuple<execution &, context &> schedule() = 0;
 
     virtual bool has_active_execution() = 0;
     virtual bool has_suspended_execution() = 0;
 
+    // 为 n 个并发 execution 预先分配私有状态，默认不做任何事
+    virtual void reserve(std::size_t) {}
+
+    // 活动队列中至少有两个 execution 时，取出一个不带子执行域的 execution 用于迁移到其它 worker
+    // 取出的 execution 随后由调用方从执行域移除并调用 detach_execution；默认不支持迁移
+    virtual execution *detach_active_execution() { return nullptr; }
+
 protected:
+    // 唤醒传递：父 execution 已挂起时一并唤醒它
+    void awake_parent() noexcept {
+        auto parent_domain = m_domain->get_parent_domain();
+        auto parent_exec = m_domain->get_parent_execution();
+        if (parent_domain
+            && parent_exec->state.load(std::memory_order::acquire) == execution_state::suspended) {
+            parent_domain->get_scheduler().awake_execution(*parent_exec);
+        }
+    }
+
     execution_domain *m_domain{nullptr};
 };
 
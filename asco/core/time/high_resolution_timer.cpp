@@ -34,7 +34,7 @@ high_resolution_timer::register_timer(std::chrono::steady_clock::time_point time
     auto seconds_from_epoch = detail::sec_from_epoch(time_point);
     if (auto g = m_timer_tree.write()) {
         if (!g->contains(seconds_from_epoch)) {
-            // 由于 sync::spinlock 不可移动、复制，第二个参数实际上会在哈希表中原地构造一个
+            // 由于 sync::mcs_spinlock 不可移动、复制，第二个参数实际上会在哈希表中原地构造一个
             // entry_area{seconds_from_epoch, {}}
             g->emplace(seconds_from_epoch, seconds_from_epoch);
         }
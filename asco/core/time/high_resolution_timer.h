@@ -10,7 +10,7 @@
 #include <unordered_set>
 
 #include <asco/core/time/timer.h>
-#include <asco/sync/spinlock.h>
+#include <asco/sync/mcs_spinlock.h>
 #include <asco/sync/spinrwlock.h>
 
 namespace asco::core::time {
@@ -37,9 +37,9 @@ private:
 
     struct entry_area {
         std::size_t seconds_from_epoch;
-        mutable sync::spinlock<std::map<timer_id, timer_entry>> entries{};
+        mutable sync::mcs_spinlock<std::map<timer_id, timer_entry>> entries{};
 
-        mutable sync::spinlock<std::unordered_set<timer_id>> removed_entries;
+        mutable sync::mcs_spinlock<std::unordered_set<timer_id>> removed_entries;
     };
 
     sync::spinrwlock<std::map<std::size_t, entry_area>> m_timer_tree;
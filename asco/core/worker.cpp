@@ -3,16 +3,23 @@
 
 #include <asco/core/worker.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <format>
 #include <functional>
 #include <memory>
 #include <ranges>
-#include <semaphore>
 #include <stop_token>
+#include <tuple>
 #include <utility>
+#include <vector>
 
+#include <asco/concurrency/concurrency.h>
+#include <asco/core/mm/coroutine_pool.h>
+#include <asco/core/mm/pages.h>
 #include <asco/core/os/process.h>
 #include <asco/core/runtime.h>
 #include <asco/panic.h>
@@ -20,18 +27,28 @@
 namespace asco::core {
 
 worker::worker(
-    std::size_t id, detail::coroutine_receiver rx,
-    std::shared_ptr<std::counting_semaphore<detail::coroutine_queue_capacity + 1>> backsem,
-    void *runtime_storage_ptr, void *runtime_ptr, detail::idle_workers_sender idle_tx)
+    std::size_t id, detail::injection_queue &injection_queue, void *runtime_storage_ptr, void *runtime_ptr,
+    detail::idle_workers_sender idle_tx, detail::scheduler_factory make_scheduler,
+    detail::task_capacity capacity)
         : daemon(std::format("asco::w{}", id))
-        , m_execution_domain{m_scheduler}
+        , m_scheduler{make_scheduler()}
+        , m_execution_domain{*m_scheduler}
+        , m_task_capacity{capacity}
         , m_id{id}
-        , m_coroutine_rx{std::move(rx)}
-        , m_backsem{std::move(backsem)}
+        , m_injection_queue{injection_queue}
         , m_idle_workers_tx{idle_tx}
         , m_runtime_storage_ptr{runtime_storage_ptr}
         , m_runtime_ptr{runtime_ptr} {
-    m_scheduler.bind_execution_domain(m_execution_domain);
+    m_scheduler->bind_execution_domain(m_execution_domain);
+    if (auto n = m_task_capacity.tasks) {
+        m_execution_domain.reserve(n);
+        m_scheduler->reserve(n);
+        m_coroutine_metas.reserve(n);
+        m_spare_metas.reserve(n);
+        while (m_spare_metas.size() < m_spare_metas.capacity()) {
+            m_spare_metas.push_back(std::make_unique<detail::coroutine_meta>());
+        }
+    }
     auto _ = daemon::start();
 }
 
@@ -53,17 +70,32 @@ bool worker::init() {
         panic("worker::init: 设置线程亲和性失败");
     }
 
+    // 大页开关与 coroutine_pool 都是线程局部的，需要在 worker 线程上设置并预留
+    mm::set_huge_pages(runtime::_current_runtime->m_huge_pages);
+    if (m_task_capacity.tasks) {
+        mm::coroutine_pool::reserve(m_task_capacity.block_size, m_task_capacity.tasks);
+    }
+
     return true;
 }
 
 bool worker::run_once(std::stop_token &st) {
-    if (!fetch_task() && !m_scheduler.has_active_execution()) {
-        m_idle_workers_tx.try_send(m_id);
-        sleep_until_awake();
+    if (m_retired_forwards_size.load(std::memory_order::acquire)) {
+        drain_retired_forwards();
+    }
+
+    if (!fetch_task() && !m_scheduler->has_active_execution() && !steal_task()) {
+        if (!search_for_work(st)) {
+            park();
+        }
         return true;
     }
 
-    if (m_scheduler.has_active_execution()) {
+    if (reinterpret_cast<runtime *>(m_runtime_ptr)->m_parked.load(std::memory_order::relaxed)) {
+        try_donate();
+    }
+
+    if (m_scheduler->has_active_execution()) {
         auto exit_stack = [&](bool executed = false) {
             if (!executed) {
                 std::ranges::for_each(m_context_stack, [](auto &ctx) { ctx->begin(); });
@@ -97,7 +129,7 @@ bool worker::run_once(std::stop_token &st) {
                     // 适应性挂起，对应调度器的唤醒应有唤醒传递，将当前 execution 的唤醒向所在
                     // execution_domain 的父 execution 传递
                     current_domain->get_parent_domain()->get_scheduler().suspend_current(
-                        m_sexec_stack.back().m_id);
+                        *m_sexec_stack.back().m_exec);
                     // suspend_current 内部设置挂起标志，随后 exit_stack 中的 ctx->end(false) 会挂起当前
                     // execution 这与普通的协程挂起是一致的
                     exit_stack();
@@ -106,12 +138,19 @@ bool worker::run_once(std::stop_token &st) {
             }
         } while (current_domain);
 
-        if (!m_executor.execute(m_sexec_stack.back(), m_context_stack)) {
+        if (!m_executor.execute(m_sexec_stack.back(), m_context_stack.span())) {
             auto &domain = *m_domain_stack.back();
             auto exec = m_sexec_stack.back().m_id;
-            m_coroutine_metas.remove(exec);
-            domain.get_scheduler().detach_suspended_execution(exec);
-            domain.detach_execution(exec);
+            // 先从执行域移除，等待其它线程上的唤醒结束后再释放调度器状态
+            auto record = domain.detach_execution(exec);
+            domain.get_scheduler().detach_execution(*record);
+            domain.recycle_execution(std::move(record));
+            if (auto meta = m_coroutine_metas.remove(exec)) {
+                recycle_meta(std::move(*meta));
+            }
+            if (m_migration_hops.size()) {
+                retire_forwards(exec);
+            }
         }
 
         exit_stack(true);
@@ -125,30 +164,289 @@ executed_once:
 void worker::shutdown() {}
 
 bool worker::fetch_task() {
-    if (auto meta = m_coroutine_rx.try_recv()) {
-        m_backsem->release();
-        auto handle = meta->handle;
-        new (meta->pcancel_awake_token_storage->get()) awake_token{this, &m_execution_domain, meta->handle};
-        meta->pcancel_awake_token_location->store(
-            meta->pcancel_awake_token_storage->get(), std::memory_order::release);
-        m_coroutine_metas.insert(handle, std::move(*meta));
-        m_execution_domain.attach_execution(handle, {}, meta->cancel_source);
-        m_scheduler.attach_execution(handle);
+    if (m_inbox_size.load(std::memory_order::acquire) && adopt_migrated()) {
         return true;
     }
+    if (++m_fetch_tick % global_queue_interval == 0) {
+        if (auto meta = recv_global_task()) {
+            attach_task(std::move(*meta));
+            return true;
+        }
+    }
+    if (auto meta = m_local_queue.pop()) {
+        attach_task(std::move(*meta));
+        return true;
+    }
+    if (auto meta = recv_global_task()) {
+        attach_task(std::move(*meta));
+        return true;
+    }
+    return false;
+}
+
+bool worker::steal_task() {
+    auto &rt = *reinterpret_cast<runtime *>(m_runtime_ptr);
+    if (!rt.m_workers_started.load(std::memory_order::acquire)) {
+        return false;
+    }
+
+    auto n = rt.m_workers.size();
+    auto start = m_steal_cursor++;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto &victim = *rt.m_workers[(start + i) % n];
+        if (&victim == this || !victim.m_local_queue.size()) {
+            continue;
+        }
+        if (victim.m_local_queue.steal_half_into(m_local_queue)) {
+            return fetch_task();
+        }
+    }
     return false;
 }
 
+bool worker::search_for_work(std::stop_token &st) {
+    auto &rt = *reinterpret_cast<runtime *>(m_runtime_ptr);
+    if (!rt.try_begin_search()) {
+        return false;
+    }
+
+    bool found = false;
+    for (std::size_t i = 0; i < m_spin_rounds && !st.stop_requested(); ++i) {
+        concurrency::exp_withdraw(i);
+        if (fetch_task() || m_scheduler->has_active_execution() || steal_task()) {
+            found = true;
+            break;
+        }
+    }
+
+    auto last = rt.end_search();
+    if (!found) {
+        m_spin_rounds = std::max(m_spin_rounds / 2, spin_rounds_min);
+        return false;
+    }
+
+    m_spin_hits.fetch_add(1, std::memory_order::relaxed);
+    m_spin_rounds = std::min(m_spin_rounds * 2, spin_rounds_max);
+    // 搜索期间其它任务的唤醒可能因本 worker 而被省略，最后一个搜索者退出时把搜索接力给下一个 worker
+    if (last && rt.has_visible_work()) {
+        rt.awake_next();
+    }
+    return true;
+}
+
+void worker::park() {
+    auto &rt = *reinterpret_cast<runtime *>(m_runtime_ptr);
+    // 上次的登记还没被取走时不重复登记：取走登记的一方会在清除标记后唤醒本 worker
+    if (!m_idle_listed.exchange(true, std::memory_order::acq_rel)) {
+        m_idle_workers_tx.try_send(m_id);
+    }
+    // 与 runtime::awake_next 配对：登记空闲后复查一次，要么唤醒方看到本 worker 空闲，要么这里看到新任务
+    std::atomic_thread_fence(std::memory_order::seq_cst);
+    if (rt.has_visible_work()) {
+        // 登记留在空闲队列中，之后至多造成一次多余的唤醒；标记保证每个 worker 只留下一条登记
+        return;
+    }
+    m_parks.fetch_add(1, std::memory_order::relaxed);
+    // 休眠前收缩协程内存池，突发流量留下的缓存超过高水位时归还给系统
+    mm::coroutine_pool::trim_on_idle();
+    rt.m_parked.fetch_add(1, std::memory_order::relaxed);
+    sleep_until_awake();
+    rt.m_parked.fetch_sub(1, std::memory_order::relaxed);
+}
+
+void worker::try_donate() {
+    auto &rt = *reinterpret_cast<runtime *>(m_runtime_ptr);
+    // 与 runtime 析构配对：析构开始后不再向其它 worker 的收件箱投递
+    rt.m_donating.fetch_add(1, std::memory_order::seq_cst);
+    if (!rt.m_stopping.load(std::memory_order::seq_cst)
+        && rt.m_workers_started.load(std::memory_order::acquire)) {
+        donate_one();
+    }
+    rt.m_donating.fetch_sub(1, std::memory_order::release);
+}
+
+void worker::donate_one() {
+    auto &rt = *reinterpret_cast<runtime *>(m_runtime_ptr);
+
+    auto target_id = rt.m_idle_workers_rx.try_recv();
+    if (!target_id) {
+        return;
+    }
+    if (*target_id == m_id) {
+        // 本 worker 自己留下的空闲登记已经过时，直接丢弃
+        m_idle_listed.store(false, std::memory_order::release);
+        return;
+    }
+    auto &target = *rt.m_workers[*target_id];
+
+    auto picked = m_scheduler->detach_active_execution();
+    if (!picked) {
+        m_idle_workers_tx.try_send(*target_id);
+        return;
+    }
+    auto exec = picked->id;
+
+    // 出队后的 execution 仍处于活动状态，从执行域移出期间到达的唤醒不需要生效
+    auto record = m_execution_domain.take_execution(exec);
+    auto preawaken = m_scheduler->detach_execution(*record);
+    // 记录随 execution 交给目标 worker ，结束后回收到目标的空位中；本 worker 补回一个空位
+    m_execution_domain.refill_spare_records();
+
+    auto meta = m_coroutine_metas.remove(exec);
+    asco_assert(meta);
+    auto hops = m_migration_hops.remove(exec).value_or(std::vector<detail::migration_hop>{});
+    auto serial = rt.m_migration_serial.fetch_add(1, std::memory_order::relaxed);
+    hops.push_back({this, serial});
+
+    // 先登记转发再投递：目标 worker 开始运行该 execution 之后，旧的 awake_token 都能经由转发找到它
+    // 迁移途中到达的唤醒会被丢弃，此时 execution 本就处于活动状态，这些唤醒是多余的
+    m_forwards.remove(exec);
+    m_forwards.insert(exec, detail::execution_forward{&target, serial});
+
+    {
+        auto g = target.m_inbox.lock();
+        g->push_back(
+            detail::migrated_execution{std::move(*meta), std::move(record), std::move(hops), preawaken});
+        target.m_inbox_size.fetch_add(1, std::memory_order::release);
+    }
+    rt.m_migrations.fetch_add(1, std::memory_order::relaxed);
+    target.m_idle_listed.store(false, std::memory_order::release);
+    target.awake();
+}
+
+bool worker::adopt_migrated() {
+    std::deque<detail::migrated_execution> batch;
+    {
+        auto g = m_inbox.lock();
+        batch.swap(*g);
+        m_inbox_size.fetch_sub(batch.size(), std::memory_order::release);
+    }
+
+    for (auto &m : batch) {
+        auto id = m.exec->id;
+        // 迁回曾经的所有者时，删除自己留下的转发记录，之后的唤醒直接落在本 worker
+        m_forwards.remove(id);
+        std::erase_if(m.hops, [this](const detail::migration_hop &hop) { return hop.from == this; });
+
+        auto &exec = m_execution_domain.adopt_execution(std::move(m.exec));
+        m_scheduler->attach_execution(exec);
+        if (m.preawaken) {
+            m_scheduler->awake_execution(exec);
+        }
+        if (!m.hops.empty()) {
+            m_migration_hops.insert(id, std::move(m.hops));
+        }
+        m_coroutine_metas.insert(id, std::move(m.meta));
+    }
+    return !batch.empty();
+}
+
+void worker::retire_forwards(task::execution_id exec) {
+    auto hops = m_migration_hops.remove(exec);
+    if (!hops) {
+        return;
+    }
+    for (auto &hop : *hops) {
+        auto g = hop.from->m_retired_forwards.lock();
+        g->emplace_back(exec, hop.serial);
+        hop.from->m_retired_forwards_size.fetch_add(1, std::memory_order::release);
+    }
+}
+
+void worker::drain_retired_forwards() {
+    std::vector<std::tuple<task::execution_id, std::uint64_t>> retired;
+    {
+        auto g = m_retired_forwards.lock();
+        retired.swap(*g);
+        m_retired_forwards_size.fetch_sub(retired.size(), std::memory_order::release);
+    }
+
+    for (auto [exec, serial] : retired) {
+        // 同一地址的 execution 可能已经再次迁出，只删除序号匹配的那条记录
+        bool matched = false;
+        if (auto g = m_forwards.get(exec)) {
+            matched = g.value().serial == serial;
+        }
+        if (matched) {
+            m_forwards.remove(exec);
+        }
+    }
+}
+
+worker *worker::resolve_owner(task::execution_id exec) noexcept {
+    // 没有任何转发记录时 execution 不可能从本 worker 迁出
+    if (!m_forwards.size()) {
+        return this;
+    }
+    auto &rt = *reinterpret_cast<runtime *>(m_runtime_ptr);
+    auto w = this;
+    // 迁移途中转发链可能暂时成环，最多跟随 worker 数量次
+    for (std::size_t i = 0; i < rt.m_workers.size() && !w->m_coroutine_metas.contains(exec); ++i) {
+        worker *next{nullptr};
+        if (auto g = w->m_forwards.get(exec)) {
+            next = g.value().to;
+        }
+        if (!next) {
+            break;
+        }
+        w = next;
+    }
+    return w;
+}
+
+std::optional<detail::coroutine_meta> worker::recv_global_task() { return m_injection_queue.pop(); }
+
+void worker::attach_task(detail::coroutine_meta &&meta) {
+    auto handle = meta.handle;
+    new (meta.pcancel_awake_token_storage->get()) awake_token{this, &m_execution_domain, handle};
+    meta.pcancel_awake_token_location->store(
+        meta.pcancel_awake_token_storage->get(), std::memory_order::release);
+    std::unique_ptr<detail::coroutine_meta> owned_meta;
+    if (!m_spare_metas.empty()) {
+        owned_meta = std::move(m_spare_metas.back());
+        m_spare_metas.pop_back();
+        *owned_meta = std::move(meta);
+    } else {
+        owned_meta = std::make_unique<detail::coroutine_meta>(std::move(meta));
+    }
+    auto &exec = m_execution_domain.attach_execution(handle, {}, owned_meta->cancel_source);
+    exec.task_meta = owned_meta.get();
+    m_coroutine_metas.insert(handle, std::move(owned_meta));
+    m_scheduler->attach_execution(exec);
+    reinterpret_cast<runtime *>(m_runtime_ptr)->on_task_attached();
+}
+
+void worker::recycle_meta(std::unique_ptr<detail::coroutine_meta> meta) noexcept {
+    // 空位已满时直接释放，不让 vector 扩容
+    if (m_spare_metas.size() < m_spare_metas.capacity()) {
+        // 任务局部存储与分配区随任务结束一并释放
+        meta->tls = util::safe_erased{};
+        meta->arena.reset();
+        m_spare_metas.push_back(std::move(meta));
+    }
+}
+
 awake_token::awake_token()
         : m_worker{&worker::current()}
         , m_domain{&m_worker->get_current_execution_domain()}
         , m_exec{m_worker->get_executor().current_execution()} {}
 
-void awake_token::suspend() noexcept { m_domain->get_scheduler().suspend_current(m_exec); }
+void awake_token::suspend() noexcept {
+    m_domain->get_scheduler().suspend_current(*m_worker->get_executor().current_execution_record());
+}
+
+void awake_token::awake() noexcept { mark_runnable()->awake(); }
 
-void awake_token::awake() noexcept {
-    m_domain->get_scheduler().awake_execution(m_exec);
-    m_worker->awake();
+worker *awake_token::mark_runnable() const noexcept {
+    auto w = m_worker;
+    auto domain = m_domain;
+    if (domain == &w->m_execution_domain) {
+        // 顶层 execution 可能已被迁移到其它 worker
+        w = w->resolve_owner(m_exec);
+        domain = &w->m_execution_domain;
+    }
+    domain->awake_execution(m_exec);
+    return w;
 }
 
 std::size_t awake_token::hash() const noexcept {
@@ -158,4 +456,23 @@ std::size_t awake_token::hash() const noexcept {
     return h1 ^ (h2 << 1) ^ (h3 << 2);
 }
 
+void awake_batch::add(const awake_token &token) noexcept {
+    auto w = token.mark_runnable();
+    auto recorded = m_workers.begin() + m_count;
+    if (w == worker::try_current() || std::find(m_workers.begin(), recorded, w) != recorded) {
+        return;
+    }
+    if (m_count == max_workers) {
+        flush();
+    }
+    m_workers[m_count++] = w;
+}
+
+void awake_batch::flush() noexcept {
+    for (std::size_t i = 0; i < m_count; ++i) {
+        m_workers[i]->awake();
+    }
+    m_count = 0;
+}
+
 };  // namespace asco::core
@@ -3,30 +3,39 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <coroutine>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <memory>
-#include <semaphore>
+#include <optional>
 #include <stop_token>
+#include <tuple>
 #include <vector>
 
 #include <asco/concurrency/hash_map.h>
 #include <asco/concurrency/ring_queue.h>
+#include <asco/core/blocking_pool.h>
 #include <asco/core/cancellation.h>
 #include <asco/core/daemon.h>
-#include <asco/core/task/dynprio_scheduler.h>
+#include <asco/core/mm/task_arena.h>
+#include <asco/core/task/scheduler.h>
 #include <asco/core/task/execution_domain.h>
 #include <asco/core/task/executor.h>
 #include <asco/panic.h>
+#include <asco/sync/spinlock.h>
 #include <asco/this_task.h>
+#include <asco/util/compile_config.h>
+#include <asco/util/inline_stack.h>
 #include <asco/util/raw_storage.h>
 #include <asco/util/safe_erased.h>
 
 namespace asco::core {
 
 class awake_token;
+class worker;
 
 namespace detail {
 
@@ -36,7 +45,7 @@ struct coroutine_meta {
     util::raw_storage<awake_token> *pcancel_awake_token_storage;
     cancel_source *cancel_source;
     util::safe_erased tls;
-    bool blocking;
+    mm::task_arena::handle arena{};  // 首次调用 this_task::arena() 时创建，任务结束时释放
 };
 
 struct task {
@@ -52,6 +61,164 @@ using coroutine_receiver = concurrency::ring_queue::receiver<coroutine_meta, cor
 static constexpr auto coroutine_queue_create =
     concurrency::ring_queue::create<coroutine_meta, coroutine_queue_capacity>;
 
+// 全局注入队列：无锁环形队列作为快速路径，环形队列满时溢出到无界的后备队列，push 永不阻塞
+class injection_queue {
+public:
+    injection_queue() {
+        auto [tx, rx] = coroutine_queue_create();
+        m_tx = std::move(tx);
+        m_rx = std::move(rx);
+    }
+
+    injection_queue(const injection_queue &) = delete;
+    injection_queue &operator=(const injection_queue &) = delete;
+
+    void push(coroutine_meta &&meta) {
+        // 后备队列非空时直接追加到后备队列，尽量保持先进先出
+        if (!m_overflow_size.load(std::memory_order::acquire)) {
+            if (auto rejected = m_tx.try_send(std::move(meta))) {
+                meta = std::move(*rejected);
+            } else {
+                return;
+            }
+        }
+        auto g = m_overflow.lock();
+        g->push_back(std::move(meta));
+        m_overflow_size.fetch_add(1, std::memory_order::release);
+    }
+
+    // 整批一次性发布到后备队列，只获取一次锁
+    void push_batch(std::vector<coroutine_meta> &metas) {
+        auto g = m_overflow.lock();
+        for (auto &meta : metas) {
+            g->push_back(std::move(meta));
+        }
+        m_overflow_size.fetch_add(metas.size(), std::memory_order::release);
+    }
+
+    std::optional<coroutine_meta> pop() {
+        if (auto meta = m_rx.try_recv()) {
+            return meta;
+        }
+        if (!m_overflow_size.load(std::memory_order::acquire)) {
+            return std::nullopt;
+        }
+        auto g = m_overflow.lock();
+        if (g->empty()) {
+            return std::nullopt;
+        }
+        auto meta = std::move(g->front());
+        g->pop_front();
+        m_overflow_size.fetch_sub(1, std::memory_order::release);
+        return meta;
+    }
+
+    // 近似判断队列是否为空，供空闲 worker 在休眠前复查
+    bool empty() const noexcept {
+        return m_rx.empty() && !m_overflow_size.load(std::memory_order::acquire);
+    }
+
+private:
+    coroutine_sender m_tx;
+    coroutine_receiver m_rx;
+
+    sync::spinlock<std::deque<coroutine_meta>> m_overflow;
+    std::atomic_size_t m_overflow_size{0};
+};
+
+// worker 本地就绪队列，存放由该 worker 上的任务 spawn 出、尚未附加到执行域的协程
+// 所有者从队首取出任务；空闲 worker 从队首一次偷取一半
+class local_queue {
+public:
+    void push(coroutine_meta &&meta) {
+        auto g = m_queue.lock();
+        g->push_back(std::move(meta));
+        m_size.fetch_add(1, std::memory_order::release);
+    }
+
+    void push_batch(std::vector<coroutine_meta> &metas) {
+        auto g = m_queue.lock();
+        for (auto &meta : metas) {
+            g->push_back(std::move(meta));
+        }
+        m_size.fetch_add(metas.size(), std::memory_order::release);
+    }
+
+    std::optional<coroutine_meta> pop() {
+        if (!size()) {
+            return std::nullopt;
+        }
+        auto g = m_queue.lock();
+        if (g->empty()) {
+            return std::nullopt;
+        }
+        auto meta = std::move(g->front());
+        g->pop_front();
+        m_size.fetch_sub(1, std::memory_order::release);
+        return meta;
+    }
+
+    // 偷取本队列中一半（向上取整）的任务并移入 dst，返回偷取的数量
+    // 不会同时持有两个队列的锁，两个 worker 互相偷取时不会死锁
+    std::size_t steal_half_into(local_queue &dst) {
+        std::vector<coroutine_meta> stolen;
+        {
+            auto g = m_queue.lock();
+            auto n = (g->size() + 1) / 2;
+            if (!n) {
+                return 0;
+            }
+            stolen.reserve(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                stolen.push_back(std::move(g->front()));
+                g->pop_front();
+            }
+            m_size.fetch_sub(n, std::memory_order::release);
+        }
+        auto g = dst.m_queue.lock();
+        for (auto &meta : stolen) {
+            g->push_back(std::move(meta));
+        }
+        dst.m_size.fetch_add(stolen.size(), std::memory_order::release);
+        return stolen.size();
+    }
+
+    std::size_t size() const noexcept { return m_size.load(std::memory_order::acquire); }
+
+private:
+    sync::spinlock<std::deque<coroutine_meta>> m_queue;
+    std::atomic_size_t m_size{0};
+};
+
+// 迁出 execution 的 worker 留下的转发记录，让旧的 awake_token 能找到新的所有者
+struct execution_forward {
+    worker *to;
+    std::uint64_t serial;
+};
+
+// execution 的一次迁移：由 from 迁出，对应 from 中序号为 serial 的转发记录
+struct migration_hop {
+    worker *from;
+    std::uint64_t serial;
+};
+
+// 从繁忙 worker 迁移到空闲 worker 途中的顶层 execution
+struct migrated_execution {
+    std::unique_ptr<coroutine_meta> meta;
+    std::unique_ptr<core::task::execution> exec;
+    std::vector<migration_hop> hops;
+    bool preawaken;
+};
+
+// runtime_builder::with_task_capacity 的设置，tasks 为 0 表示不预留
+struct task_capacity {
+    std::size_t tasks;
+    std::size_t block_size;  // 每个任务从 coroutine_pool 取得的字节数（协程帧与 join 状态）
+};
+
+// 为每个 worker 创建顶层调度器
+using scheduler_factory = std::unique_ptr<core::task::scheduler> (*)();
+
 static constexpr std::size_t idle_workers_capacity = 1024;
 using idle_workers_sender = concurrency::ring_queue::sender<std::size_t, idle_workers_capacity>;
 using idle_workers_receiver = concurrency::ring_queue::receiver<std::size_t, idle_workers_capacity>;
@@ -64,18 +231,20 @@ class runtime;
 
 class worker final : public daemon {
     friend class runtime;
+    friend class awake_token;
     friend cancel_token &asco::this_task::get_current_cancel_token() noexcept;
     template<typename TaskLocalStorage>
     friend TaskLocalStorage &asco::this_task::task_local() noexcept;
-    friend bool asco::this_task::is_blocking_env() noexcept;
 
 public:
     worker(
-        std::size_t id, detail::coroutine_receiver rx,
-        std::shared_ptr<std::counting_semaphore<detail::coroutine_queue_capacity + 1>> backsem,
-        void *runtime_storage_ptr, void *runtime_ptr, detail::idle_workers_sender idle_tx);
+        std::size_t id, detail::injection_queue &injection_queue, void *runtime_storage_ptr,
+        void *runtime_ptr, detail::idle_workers_sender idle_tx, detail::scheduler_factory make_scheduler,
+        detail::task_capacity capacity);
 
     static worker &current();
+    // 当前线程不是 worker 时返回 nullptr
+    static worker *try_current() noexcept { return _current_worker; }
 
     std::size_t id() const;
 
@@ -84,34 +253,94 @@ public:
 
     task::executor &get_executor() noexcept { return m_executor; }
 
+    // 在当前调度器中挂起正在运行的 execution
+    void suspend_current() noexcept {
+        get_current_scheduler().suspend_current(*m_executor.current_execution_record());
+    }
+
 private:
     bool init() override;
     bool run_once(std::stop_token &st) override;
     void shutdown() override;
 
+    // 依次从本地队列与全局队列取出一个任务并附加到本 worker 的执行域
     bool fetch_task();
+    // 从其它 worker 的本地队列偷取一半任务，并附加其中一个
+    bool steal_task();
+    std::optional<detail::coroutine_meta> recv_global_task();
+    void attach_task(detail::coroutine_meta &&meta);
+    // 交还已结束任务的元数据，预留的空位未满时留待复用
+    void recycle_meta(std::unique_ptr<detail::coroutine_meta> meta) noexcept;
+
+    // 休眠前的有界自旋阶段：成为搜索者后反复尝试取任务与偷窃，找到任务时返回 true
+    // 同一时刻的搜索者数量受 runtime 限制，名额已满时直接返回 false
+    bool search_for_work(std::stop_token &st);
+    // 登记为空闲并休眠，直到被唤醒
+    void park();
+
+    // 本 worker 活动的顶层 execution 不止一个且有 worker 在休眠时，把其中一个交给休眠的 worker
+    void try_donate();
+    void donate_one();
+    // 接收其它 worker 迁移来的 execution，接收到至少一个时返回 true
+    bool adopt_migrated();
+    // 顶层 execution 结束时通知它迁移途经的 worker 删除转发记录
+    void retire_forwards(task::execution_id exec);
+    void drain_retired_forwards();
+    // 沿转发记录找到当前拥有该顶层 execution 的 worker
+    worker *resolve_owner(task::execution_id exec) noexcept;
+
+    // 每取出这么多次任务便优先检查一次全局队列，避免本地队列一直非空时全局队列中的任务饥饿
+    static constexpr std::size_t global_queue_interval = 61;
+
+    // 自旋轮数的自适应范围：自旋找到任务时加倍，落空时减半
+    static constexpr std::size_t spin_rounds_min = 8;
+    static constexpr std::size_t spin_rounds_max = 128;
 
     // 运行时上下文
-    std::vector<task::execution_domain *> m_domain_stack;
-    std::vector<task::scheduler_context *> m_context_stack;
-    std::vector<task::scheduled_execution> m_sexec_stack;
+    // 嵌套深度有上限，栈直接放在 worker 内，调度循环中不分配内存
+    static constexpr std::size_t runtime_stack_capacity =
+        util::compile_config::core::task::execution_domain_nest_max_depth + 1;
+    util::inline_stack<task::execution_domain *, runtime_stack_capacity> m_domain_stack;
+    util::inline_stack<task::scheduler_context *, runtime_stack_capacity> m_context_stack;
+    util::inline_stack<task::scheduled_execution, runtime_stack_capacity> m_sexec_stack;
 
     task::executor m_executor;
 
-    task::dynprio_scheduler m_scheduler;
+    std::unique_ptr<task::scheduler> m_scheduler;
     task::execution_domain m_execution_domain;
 
-    concurrency::hash_map<std::coroutine_handle<>, detail::coroutine_meta> m_coroutine_metas;
+    // 持有顶层任务的元数据，运行中通过 execution::task_meta 直接访问
+    concurrency::hash_map<std::coroutine_handle<>, std::unique_ptr<detail::coroutine_meta>> m_coroutine_metas;
+    // 预留的任务元数据，容量即预留数量
+    std::vector<std::unique_ptr<detail::coroutine_meta>> m_spare_metas;
+    const detail::task_capacity m_task_capacity;
 
     const std::size_t m_id;
 
-    detail::coroutine_receiver m_coroutine_rx;
-    std::shared_ptr<std::counting_semaphore<detail::coroutine_queue_capacity + 1>> m_backsem;
+    detail::local_queue m_local_queue;
+    std::size_t m_fetch_tick{0};
+    std::size_t m_steal_cursor{0};
+    std::size_t m_spin_rounds{spin_rounds_min};
+
+    // 休眠统计，只由本 worker 写入
+    std::atomic_size_t m_parks{0};
+    std::atomic_size_t m_spin_hits{0};
+
+    // 迁移：m_forwards 只由本 worker 写入；m_migration_hops 记录迁移到本 worker 的 execution 途经的 worker
+    sync::spinlock<std::deque<detail::migrated_execution>> m_inbox;
+    std::atomic_size_t m_inbox_size{0};
+    concurrency::hash_map<task::execution_id, detail::execution_forward> m_forwards;
+    concurrency::hash_map<task::execution_id, std::vector<detail::migration_hop>> m_migration_hops;
+    sync::spinlock<std::vector<std::tuple<task::execution_id, std::uint64_t>>> m_retired_forwards;
+    std::atomic_size_t m_retired_forwards_size{0};
+
+    detail::injection_queue &m_injection_queue;
 
     detail::idle_workers_sender m_idle_workers_tx;
+    // 空闲队列中是否留有本 worker 的登记，取走登记的一方负责清除
+    std::atomic_bool m_idle_listed{false};
 
-    // 仅能在 init() 中安全使用
-    void *m_runtime_storage_ptr;
+    void *m_runtime_storage_ptr;  // 仅能在 init() 中安全使用
     void *m_runtime_ptr;
 
     inline thread_local static worker *_current_worker{nullptr};
@@ -119,6 +348,7 @@ private:
 
 class awake_token {
     friend class worker;
+    friend class awake_batch;
 
 public:
     awake_token();
@@ -134,20 +364,47 @@ private:
             , m_domain{d}
             , m_exec{exec} {}
 
+    // 把 execution 标记为可运行，返回需要被通知的 worker
+    worker *mark_runnable() const noexcept;
+
     worker *m_worker;
     task::execution_domain *m_domain;
     task::execution_id m_exec;
 };
 
+// 成批唤醒：立即把每个 token 的 execution 标记为可运行，但每个 worker 只通知一次
+// 当前线程所在的 worker 正在运行，不需要通知；析构时通知尚未通知的 worker
+class awake_batch {
+public:
+    awake_batch() = default;
+    ~awake_batch() { flush(); }
+
+    awake_batch(const awake_batch &) = delete;
+    awake_batch &operator=(const awake_batch &) = delete;
+
+    void add(const awake_token &token) noexcept;
+    void flush() noexcept;
+
+private:
+    // 记录满时提前通知一次，不分配内存
+    static constexpr std::size_t max_workers = 16;
+
+    std::array<worker *, max_workers> m_workers;
+    std::size_t m_count{0};
+};
+
 };  // namespace asco::core
 
 namespace asco::this_task {
 
 template<typename TaskLocalStorage>
 TaskLocalStorage &task_local() noexcept {
+    if (auto job = core::blocking_pool::current_job()) {
+        return job->tls.get<TaskLocalStorage>();
+    }
     auto &w = core::worker::current();
-    if (auto exec = w.m_executor.current_execution()) {
-        auto &tls = w.m_coroutine_metas.get(exec).value().tls;
+    if (auto exec = w.m_executor.current_execution_record(); exec && exec->task_meta) {
+        auto &tls = static_cast<core::detail::coroutine_meta *>(exec->task_meta)->tls;
         return tls.get<TaskLocalStorage>();
     } else {
         panic("asco::this_task::task_local: 当前没有正在运行的任务");
@@ -12,10 +12,13 @@
 #include <utility>
 
 #include <asco/core/mm/coroutine_pool.h>
+#include <asco/core/mm/frame_profiler.h>
 #include <asco/core/worker.h>
 #include <asco/panic.h>
+#include <asco/util/compile_config.h>
 #include <asco/util/erased.h>
 #include <asco/util/raw_storage.h>
+#include <asco/util/type_id.h>
 #include <asco/util/types.h>
 
 namespace asco {
@@ -35,7 +38,10 @@ public:
 
     class promise_base {
     public:
+        // 协程帧在 final_suspend 时即被销毁，结果写入等待方持有的 future
         future *m_future_object;
+        // co_invoke 绑定的闭包与协程帧同生命周期
+        util::boxed m_bound_lambda;
     };
 
     class promise_void_mixin : public promise_base {
@@ -58,16 +64,30 @@ public:
 
     class promise_type final : public promise_spanwidth {
     public:
-        void *operator new(std::size_t size) noexcept { return core::mm::coroutine_pool::allocate(size); }
+        void *operator new(std::size_t size) noexcept {
+            auto frame = core::mm::coroutine_pool::allocate(size);
+            if constexpr (util::compile_config::perf_record) {
+                core::mm::frame_profiler::on_allocate(frame, size);
+            }
+            return frame;
+        }
 
         void operator delete(void *ptr, std::size_t size) noexcept {
+            if constexpr (util::compile_config::perf_record) {
+                core::mm::frame_profiler::on_deallocate(ptr);
+            }
             core::mm::coroutine_pool::deallocate(ptr, size);
         }
 
         static future get_return_object_on_allocation_failure() { throw std::bad_alloc(); }
 
         future get_return_object() noexcept {
-            return future{std::coroutine_handle<promise_type>::from_promise(*this), &this->m_future_object};
+            if constexpr (util::compile_config::perf_record) {
+                core::mm::frame_profiler::on_construct(
+                    std::coroutine_handle<promise_type>::from_promise(*this).address(),
+                    util::type_id::of<promise_type>().name());
+            }
+            return future{std::coroutine_handle<promise_type>::from_promise(*this)};
         }
 
         auto initial_suspend() noexcept { return std::suspend_always{}; }
@@ -83,7 +103,7 @@ public:
 
                 bool await_ready() noexcept { return false; }
 
-                void await_suspend(std::coroutine_handle<>) noexcept {
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<>) noexcept {
                     auto &w = core::worker::current();
                     auto &exe = w.get_executor();
                     auto wchdl = exe.pop_handle();
@@ -91,28 +111,34 @@ public:
                     if (exe.is_base_coroutine(wchdl)) {
                         // worker 任务清理 / 空子执行域协议的协议动作：保证当前 execution 是 suspended
                         // execution，保证被 worker 正确清理，进一步保证当前执行域符合空子执行域协议
-                        w.get_current_scheduler().suspend_current(wchdl);
+                        w.suspend_current();
                     }
+                    // 调用方位于 handle_stack 栈顶，直接转移回调用方而不经过 worker
+                    auto next = exe.current_coroutine();
                     this_handle.destroy();
-                    return;
+                    if (next && exe.try_direct_transfer()) {
+                        return next;
+                    }
+                    return std::noop_coroutine();
                 }
 
                 void await_resume() noexcept {}
             };
 
-            if (this->m_future_object->m_result_completed.load(std::memory_order::acquire)) {
-                this->m_future_object->m_result_completed.store(true, std::memory_order::release);
-            }
-            return final_awaitable{this->m_future_object->m_this_handle};
+            return final_awaitable{coroutine_handle::from_promise(*this)};
         }
     };
 
     bool await_ready() noexcept { return false; }
 
-    void await_suspend(std::coroutine_handle<> handle) noexcept {
-        m_caller_handle = handle;
-        auto &w = core::worker::current();
-        w.get_executor().push_handle(m_this_handle);
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<>) noexcept {
+        auto &exe = core::worker::current().get_executor();
+        exe.push_handle(m_this_handle);
+        // 对称转移：直接恢复被等待的协程，不经过 worker 的调度
+        if (exe.try_direct_transfer()) {
+            return m_this_handle;
+        }
+        return std::noop_coroutine();
     }
 
     output_type await_resume() {
@@ -128,10 +154,8 @@ public:
         }
     }
 
-    util::erased &bind_lambda(util::erased &&l) noexcept {
-        m_bound_lambda = std::move(l);
-        return m_bound_lambda;
-    }
+    // 只能在协程开始运行之前调用
+    void bind_lambda(util::boxed &&l) noexcept { m_this_handle.promise().m_bound_lambda = std::move(l); }
 
     std::coroutine_handle<> as_execution() const noexcept { return m_this_handle; }
 
@@ -139,17 +163,18 @@ public:
     future &operator=(const future &) = delete;
 
     future(future &&rhs) noexcept
-            : m_promise_storage_ptr{rhs.m_promise_storage_ptr}
-            , m_this_handle{rhs.m_this_handle}
+            : m_this_handle{rhs.m_this_handle}
             , m_e_ptr{std::move(rhs.m_e_ptr)}
-            , m_result_completed{rhs.m_result_completed.load(std::memory_order::relaxed)}
-            , m_caller_handle{rhs.m_caller_handle}
-            , m_bound_lambda{std::move(rhs.m_bound_lambda)} {
-        *m_promise_storage_ptr = this;
-        if constexpr (!output_void) {
-            if (m_result_completed.load(std::memory_order::acquire) && !m_e_ptr) {
-                new (m_value.get()) output_type{std::move(*rhs.m_value.get())};
+            , m_result_completed{rhs.m_result_completed.load(std::memory_order::relaxed)} {
+        if (m_result_completed.load(std::memory_order::acquire)) {
+            if constexpr (!output_void) {
+                if (!m_e_ptr) {
+                    new (m_value.get()) output_type{std::move(*rhs.m_value.get())};
+                }
             }
+        } else {
+            // 尚未完成时协程帧仍然存在，让 promise 指向新的 future
+            m_this_handle.promise().m_future_object = this;
         }
     }
 
@@ -172,23 +197,16 @@ public:
     }
 
 private:
-    future(std::coroutine_handle<promise_type> handle, future **promise_storage_ptr) noexcept
-            : m_this_handle{handle}
-            , m_promise_storage_ptr{promise_storage_ptr} {
-        *promise_storage_ptr = this;
+    explicit future(std::coroutine_handle<promise_type> handle) noexcept
+            : m_this_handle{handle} {
+        handle.promise().m_future_object = this;
     }
 
-    future **m_promise_storage_ptr{nullptr};
-
+    // 挂起的调用方的协程帧内联持有 future ，字段保持最少：等待方的句柄由执行器的 handle_stack 记录
     std::coroutine_handle<promise_type> m_this_handle;
-
     std::exception_ptr m_e_ptr;
     [[no_unique_address]] util::raw_storage<output_type> m_value{};
     std::atomic_bool m_result_completed{false};
-
-    std::coroutine_handle<> m_caller_handle;
-
-    util::erased m_bound_lambda;
 };
 
 template<typename F>
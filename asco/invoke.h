@@ -3,16 +3,38 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <type_traits>
 #include <utility>
 
+#include <asco/core/mm/coroutine_pool.h>
 #include <asco/future.h>
 #include <asco/join_handle.h>
+#include <asco/panic.h>
 #include <asco/util/erased.h>
 
 namespace asco {
 
+namespace detail {
+
+// 绑定到协程上的闭包与协程帧一样从 coroutine_pool 分配
+struct bound_lambda_allocator {
+    static void *allocate(std::size_t size, std::size_t) noexcept {
+        auto ptr = core::mm::coroutine_pool::allocate(size);
+        if (!ptr) {
+            panic("asco::co_invoke: 闭包内存分配失败");
+        }
+        return ptr;
+    }
+
+    static void deallocate(void *ptr, std::size_t size, std::size_t) noexcept {
+        core::mm::coroutine_pool::deallocate(ptr, size);
+    }
+};
+
+};  // namespace detail
+
 template<typename... Args, typename Fn>
     requires(
         (async_function<Fn, Args...> || spawned_function<Fn, Args...>)
@@ -20,7 +42,14 @@ template<typename... Args, typename Fn>
 constexpr auto co_invoke(Fn &&f, Args &&...args) {
     if constexpr (std::is_rvalue_reference_v<decltype(f)>) {
         using FnType = std::remove_cvref_t<Fn>;
-        util::erased fnp = util::erased{std::forward<FnType>(f)};
+        // 协程按引用持有闭包，闭包不能随 future 移动而搬移，因此放在外部存储中
+        util::boxed fnp = [&] {
+            if constexpr (alignof(FnType) <= alignof(std::max_align_t)) {
+                return util::boxed::make<detail::bound_lambda_allocator>(std::forward<FnType>(f));
+            } else {
+                return util::boxed::make(std::forward<FnType>(f));
+            }
+        }();
         auto task = std::invoke(fnp.get<FnType>(), std::forward<Args>(args)...);
         task.bind_lambda(std::move(fnp));
         return task;
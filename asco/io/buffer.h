@@ -10,6 +10,7 @@
 #include <span>
 #include <string_view>
 
+#include <asco/core/mm/buffer_pool.h>
 #include <asco/core/mm/pool.h>
 
 namespace asco::io {
@@ -83,7 +84,7 @@ public:
             , m_allocator_storage{std::move(allocator)}
             , m_allocator{&*m_allocator_storage} {}
 
-    explicit buffer(std::size_t size, Alloc &allocator = core::mm::pmr::get<buffer>())
+    explicit buffer(std::size_t size, Alloc &allocator = core::mm::buffer_pool::allocator())
             : m_data{reinterpret_cast<std::byte *>(allocator.allocate_bytes(size))}
             , m_size{size}
             , m_cursor{0}
@@ -99,7 +100,7 @@ public:
         std::ranges::copy_n(reinterpret_cast<const std::byte *>(string.data()), string.size(), m_data);
     }
 
-    explicit buffer(std::string_view string, Alloc &allocator = core::mm::pmr::get<buffer>())
+    explicit buffer(std::string_view string, Alloc &allocator = core::mm::buffer_pool::allocator())
             : m_data{reinterpret_cast<std::byte *>(allocator.allocate_bytes(string.size()))}
             , m_size{string.size()}
             , m_cursor{string.size()}
@@ -162,7 +163,7 @@ private:
     std::size_t m_cursor{0};
 
     std::optional<Alloc> m_allocator_storage{std::nullopt};
-    Alloc *m_allocator{&core::mm::pmr::get<buffer>()};
+    Alloc *m_allocator{&core::mm::buffer_pool::allocator()};
 
     std::size_t try_advance(std::size_t count) noexcept {
         if (m_size == 0) {
@@ -0,0 +1,275 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <asco/core/cancellation.h>
+#include <asco/core/mm/coroutine_pool.h>
+#include <asco/core/worker.h>
+#include <asco/future.h>
+#include <asco/invoke.h>
+#include <asco/panic.h>
+#include <asco/util/raw_storage.h>
+#include <asco/util/types.h>
+
+namespace asco {
+
+// 由 runtime::spawn_many 一次提交的一组任务的句柄
+// 整组任务共享一个状态对象与一个取消源，每个任务只占用状态对象中的一个槽位
+template<util::types::move_secure Output>
+class [[nodiscard]] join_group final {
+    friend class core::runtime;
+
+public:
+    using output_type = Output;
+
+    static constexpr bool output_void = std::is_void_v<output_type>;
+
+private:
+    struct slot {
+        std::atomic<core::awake_token *> cancel_awake_token{nullptr};
+        util::raw_storage<core::awake_token> __cancel_awake_token_storage{};
+
+        std::exception_ptr e_ptr{};
+        [[no_unique_address]] util::raw_storage<output_type> value{};
+        std::atomic_bool completed{false};
+
+        ~slot() {
+            if (completed.load(std::memory_order::acquire) && !e_ptr) {
+                if constexpr (!output_void) {
+                    value.get()->~output_type();
+                }
+            }
+        }
+
+        bool try_mark_completed() noexcept {
+            bool e = false;
+            return completed.compare_exchange_strong(
+                e, true, std::memory_order::acq_rel, std::memory_order::relaxed);
+        }
+    };
+
+    struct group_state {
+        explicit group_state(std::size_t n)
+                : slots{std::make_unique<slot[]>(n)}
+                , size{n}
+                , remaining{n} {}
+
+        ~group_state() {
+            if (auto token = caller_awake_token.load(std::memory_order::acquire)) {
+                token->~awake_token();
+            }
+        }
+
+        // 每个槽位完成时恰好调用一次，最后一个完成的槽位负责唤醒等待方
+        void finish_one() noexcept {
+            if (remaining.fetch_sub(1, std::memory_order::seq_cst) == 1) {
+                if (auto token = caller_awake_token.load(std::memory_order::seq_cst)) {
+                    token->awake();
+                }
+            }
+        }
+
+        std::unique_ptr<slot[]> slots;
+        const std::size_t size;
+        std::atomic_size_t remaining;
+
+        std::atomic<core::awake_token *> caller_awake_token{nullptr};
+        util::raw_storage<core::awake_token> __caller_awake_token_storage{};
+
+        core::cancel_source cancel_source{};
+    };
+
+    class task final {
+    public:
+        class promise_type;
+
+        using coroutine_handle = std::coroutine_handle<promise_type>;
+
+        class promise_base {
+        public:
+            group_state *m_state;
+            std::size_t m_index;
+        };
+
+        class promise_void_mixin : public promise_base {
+        public:
+            void return_void() noexcept {
+                if (this->m_state->slots[this->m_index].try_mark_completed()) {
+                    this->m_state->finish_one();
+                }
+            }
+        };
+
+        class promise_nonvoid_mixin : public promise_base {
+        public:
+            void return_value(output_type value) noexcept {
+                auto &s = this->m_state->slots[this->m_index];
+                if (s.try_mark_completed()) {
+                    new (s.value.get()) util::types::monostate_if_void<output_type>{std::move(value)};
+                    this->m_state->finish_one();
+                }
+            }
+        };
+
+        using promise_spanwidth =
+            std::conditional_t<output_void, promise_void_mixin, promise_nonvoid_mixin>;
+
+        class promise_type final : public promise_spanwidth {
+        public:
+            // 协程参数即 run_one 的参数：状态对象、槽位序号与可调用对象
+            template<typename Fn>
+            promise_type(const std::shared_ptr<group_state> &state, std::size_t index, Fn &) noexcept {
+                this->m_state = state.get();
+                this->m_index = index;
+            }
+
+            void *operator new(std::size_t size) noexcept { return core::mm::coroutine_pool::allocate(size); }
+
+            void operator delete(void *ptr, std::size_t size) noexcept {
+                core::mm::coroutine_pool::deallocate(ptr, size);
+            }
+
+            static task get_return_object_on_allocation_failure() { throw std::bad_alloc(); }
+
+            task get_return_object() noexcept { return task{coroutine_handle::from_promise(*this)}; }
+
+            auto initial_suspend() noexcept { return std::suspend_always{}; }
+
+            void unhandled_exception() noexcept {
+                auto &s = this->m_state->slots[this->m_index];
+                if (s.try_mark_completed()) {
+                    s.e_ptr = std::current_exception();
+                    this->m_state->finish_one();
+                }
+            }
+
+            auto final_suspend() noexcept {
+                struct final_awaitable {
+                    bool await_ready() noexcept { return false; }
+
+                    void await_suspend(coroutine_handle this_handle) noexcept {
+                        auto &w = core::worker::current();
+                        auto h = w.get_executor().pop_handle();
+                        asco_assert(this_handle == h);
+                        // worker 任务清理协议动作：只有 suspended execution 才能被正确清理
+                        w.suspend_current();
+                        this_handle.destroy();
+                    }
+
+                    void await_resume() noexcept {}
+                };
+                return final_awaitable{};
+            }
+        };
+
+        coroutine_handle handle;
+    };
+
+    struct all_awaiter {
+        group_state &state;
+
+        bool await_ready() noexcept { return !state.remaining.load(std::memory_order::acquire); }
+
+        void await_suspend(std::coroutine_handle<>) noexcept {
+            if (auto token = state.caller_awake_token.exchange(nullptr, std::memory_order::acq_rel)) {
+                token->~awake_token();
+            }
+            new (state.__caller_awake_token_storage.get()) core::awake_token{};
+            state.caller_awake_token.store(
+                state.__caller_awake_token_storage.get(), std::memory_order::seq_cst);
+            if (!state.remaining.load(std::memory_order::seq_cst)) {
+                // 全部任务已经完成，不挂起执行流，下一轮调度即恢复
+                return;
+            }
+            auto &w = core::worker::current();
+            w.suspend_current();
+        }
+
+        void await_resume() noexcept {}
+    };
+
+public:
+    std::size_t size() const noexcept { return m_state->size; }
+
+    // 等待组内全部任务完成，按提交顺序返回结果；若有任务抛出异常，重新抛出序号最小的那个
+    future<std::vector<util::types::monostate_if_void<output_type>>> join_all()
+        requires(!output_void)
+    {
+        co_await all_awaiter{*m_state};
+
+        std::vector<util::types::monostate_if_void<output_type>> res;
+        res.reserve(m_state->size);
+        for (std::size_t i = 0; i < m_state->size; ++i) {
+            auto &s = m_state->slots[i];
+            if (s.e_ptr) {
+                std::rethrow_exception(s.e_ptr);
+            }
+            res.push_back(std::move(*s.value.get()));
+        }
+        co_return res;
+    }
+
+    future<void> join_all()
+        requires(output_void)
+    {
+        co_await all_awaiter{*m_state};
+
+        for (std::size_t i = 0; i < m_state->size; ++i) {
+            if (auto &e = m_state->slots[i].e_ptr) {
+                std::rethrow_exception(e);
+            }
+        }
+        co_return;
+    }
+
+    // 取消组内所有尚未完成的任务
+    void cancel() noexcept {
+        m_state->cancel_source.request_cancel();
+        for (std::size_t i = 0; i < m_state->size; ++i) {
+            auto &s = m_state->slots[i];
+            if (s.try_mark_completed()) {
+                s.e_ptr = std::make_exception_ptr(core::coroutine_cancelled{});
+                if (auto token = s.cancel_awake_token.load(std::memory_order::acquire)) {
+                    token->awake();
+                }
+                m_state->finish_one();
+            }
+        }
+    }
+
+    void detach(this join_group &&) {}
+
+    join_group(const join_group &) = delete;
+    join_group &operator=(const join_group &) = delete;
+
+    join_group(join_group &&rhs) noexcept = default;
+    join_group &operator=(join_group &&rhs) noexcept = default;
+
+private:
+    explicit join_group(std::size_t n)
+            : m_state{std::make_shared<group_state>(n)} {}
+
+    template<typename Fn>
+    static task run_one(std::shared_ptr<group_state> state, std::size_t index, Fn fn) {
+        if constexpr (output_void) {
+            co_await co_invoke(fn);
+            co_return;
+        } else {
+            co_return co_await co_invoke(fn);
+        }
+    }
+
+    std::shared_ptr<group_state> m_state;
+};
+
+};  // namespace asco
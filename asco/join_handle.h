@@ -6,18 +6,24 @@
 #include <atomic>
 #include <concepts>
 #include <coroutine>
+#include <cstddef>
 #include <exception>
-#include <memory>
+#include <functional>
+#include <new>
 #include <semaphore>
 #include <type_traits>
 #include <utility>
 
 #include <asco/core/cancellation.h>
+#include <asco/core/mm/coroutine_pool.h>
+#include <asco/core/mm/frame_profiler.h>
 #include <asco/core/worker.h>
 #include <asco/panic.h>
+#include <asco/util/compile_config.h>
 #include <asco/util/erased.h>
 #include <asco/util/raw_storage.h>
 #include <asco/util/safe_erased.h>
+#include <asco/util/type_id.h>
 #include <asco/util/types.h>
 
 namespace asco {
@@ -40,8 +46,17 @@ private:
         completed,
     };
 
+    // 任务状态与协程帧位于同一块 coroutine_pool 内存中：状态在前，协程帧紧随其后
+    // 协程帧与 join_handle 各持有一个引用，最后一个引用释放时析构状态并归还整块内存
     struct task_state {
-        coroutine_handle this_handle;
+        explicit task_state(std::size_t block_size, std::size_t refs) noexcept
+                : refs{refs}
+                , block_size{block_size} {}
+
+        std::atomic_size_t refs;
+        const std::size_t block_size;
+
+        coroutine_handle this_handle{};
 
         std::atomic<core::awake_token *> cancel_awake_token{nullptr};
         util::raw_storage<core::awake_token> __cancel_awake_token_storage{};
@@ -54,7 +69,7 @@ private:
         std::atomic<core::awake_token *> caller_awake_token{nullptr};
         util::raw_storage<core::awake_token> __caller_awake_token_storage{};
 
-        util::erased bound_lambda{};
+        util::boxed bound_lambda{};
 
         core::cancel_source cancel_source{};
 
@@ -87,6 +102,61 @@ private:
                 e, complete_state::completed, std::memory_order::acq_rel, std::memory_order::relaxed));
             return true;
         }
+
+        static void release(task_state *state) noexcept {
+            if (state->refs.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+                auto size = state->block_size;
+                state->~task_state();
+                core::mm::coroutine_pool::deallocate(state, size);
+            }
+        }
+    };
+
+    // 协程帧在整块内存中的偏移，保持帧的默认对齐
+    static constexpr std::size_t frame_align = alignof(std::max_align_t);
+    static constexpr std::size_t frame_offset =
+        (sizeof(task_state) + frame_align - 1) / frame_align * frame_align;
+
+    // GCC 与 Clang 的协程帧地址即为 operator new 返回的地址
+    static task_state *state_of_frame(void *frame) noexcept {
+        return reinterpret_cast<task_state *>(static_cast<std::byte *>(frame) - frame_offset);
+    }
+
+    // task_state 的侵入式引用
+    class state_ref {
+    public:
+        state_ref() = default;
+
+        // 接管一个已经计入 refs 的引用
+        explicit state_ref(task_state *state) noexcept
+                : m_state{state} {}
+
+        state_ref(const state_ref &rhs) noexcept
+                : m_state{rhs.m_state} {
+            if (m_state) {
+                m_state->refs.fetch_add(1, std::memory_order::relaxed);
+            }
+        }
+
+        state_ref(state_ref &&rhs) noexcept
+                : m_state{std::exchange(rhs.m_state, nullptr)} {}
+
+        state_ref &operator=(state_ref rhs) noexcept {
+            std::swap(m_state, rhs.m_state);
+            return *this;
+        }
+
+        ~state_ref() {
+            if (m_state) {
+                task_state::release(m_state);
+            }
+        }
+
+        task_state *operator->() const noexcept { return m_state; }
+        task_state &operator*() const noexcept { return *m_state; }
+
+    private:
+        task_state *m_state{nullptr};
     };
 
 public:
@@ -94,7 +164,7 @@ public:
 
     class promise_base {
     public:
-        std::shared_ptr<task_state> m_state;
+        task_state *m_state{nullptr};
     };
 
     class promise_void_mixin : public promise_base {
@@ -127,9 +197,38 @@ public:
 
     class promise_type final : public promise_spanwidth {
     public:
+        void *operator new(std::size_t size) noexcept {
+            auto block = static_cast<std::byte *>(core::mm::coroutine_pool::allocate(frame_offset + size));
+            if (!block) {
+                return nullptr;
+            }
+            // 一个引用属于协程帧，一个属于 join_handle
+            new (block) task_state{frame_offset + size, 2};
+            if constexpr (util::compile_config::perf_record) {
+                core::mm::frame_profiler::on_allocate(block + frame_offset, frame_offset + size);
+            }
+            return block + frame_offset;
+        }
+
+        // 协程帧销毁只释放帧持有的引用，join_handle 仍可读取结果
+        void operator delete(void *ptr, std::size_t) noexcept {
+            if constexpr (util::compile_config::perf_record) {
+                core::mm::frame_profiler::on_deallocate(ptr);
+            }
+            task_state::release(state_of_frame(ptr));
+        }
+
+        static join_handle get_return_object_on_allocation_failure() { throw std::bad_alloc(); }
+
         join_handle get_return_object() noexcept {
-            this->m_state = std::make_shared<task_state>(coroutine_handle::from_promise(*this));
-            return join_handle{this->m_state};
+            auto handle = coroutine_handle::from_promise(*this);
+            if constexpr (util::compile_config::perf_record) {
+                core::mm::frame_profiler::on_construct(
+                    handle.address(), util::type_id::of<promise_type>().name());
+            }
+            this->m_state = state_of_frame(handle.address());
+            this->m_state->this_handle = handle;
+            return join_handle{state_ref{this->m_state}};
         }
 
         auto initial_suspend() noexcept { return std::suspend_always{}; }
@@ -162,7 +261,7 @@ public:
                     auto h = w.get_executor().pop_handle();
                     asco_assert(this_handle == h);
                     // worker 任务清理协议动作：只有 suspended execution 才能被正确清理
-                    w.get_current_scheduler().suspend_current(h);
+                    w.suspend_current();
                     this_handle.destroy();
                     return;
                 }
@@ -191,7 +290,7 @@ public:
             e, complete_state::awaitable_waiting, std::memory_order::acq_rel, std::memory_order::relaxed));
 
         auto &w = core::worker::current();
-        w.get_current_scheduler().suspend_current(w.get_executor().current_execution());
+        w.suspend_current();
     }
 
     output_type await_resume() {
@@ -209,10 +308,7 @@ public:
 
     void detach(this join_handle &&) {}
 
-    util::erased &bind_lambda(util::erased &&l) noexcept {
-        this->m_state->bound_lambda = std::move(l);
-        return this->m_state->bound_lambda;
-    }
+    void bind_lambda(util::boxed &&l) noexcept { this->m_state->bound_lambda = std::move(l); }
 
     void cancel() noexcept {
         if (this->m_state->try_mark_completed()) {
@@ -236,9 +332,51 @@ public:
     join_handle &operator=(join_handle &&rhs) noexcept = default;
 
 private:
-    join_handle(std::shared_ptr<task_state> state)
+    join_handle(state_ref state)
             : m_state{std::move(state)} {}
 
+    // 不对应任何协程的任务状态，供 spawn_blocking 在阻塞线程池中完成
+    static join_handle create_blocking() {
+        auto block = core::mm::coroutine_pool::allocate(sizeof(task_state));
+        if (!block) {
+            throw std::bad_alloc{};
+        }
+        return join_handle{state_ref{new (block) task_state{sizeof(task_state), 1}}};
+    }
+
+    // 在阻塞线程上运行 fn 并完成任务状态；任务已被取消时不再运行
+    template<std::invocable<> Fn>
+    static void run_blocking(task_state &state, Fn &fn) noexcept {
+        if (state.cstate.load(std::memory_order::acquire) == complete_state::completed) {
+            return;
+        }
+        auto notify = [&state] {
+            state.sync_awaiter.release();
+            if (auto awake_token = state.caller_awake_token.load(std::memory_order::acquire)) {
+                awake_token->awake();
+            }
+        };
+        try {
+            if constexpr (output_void) {
+                std::invoke(fn);
+                if (state.try_mark_completed()) {
+                    notify();
+                }
+            } else {
+                auto value = std::invoke(fn);
+                if (state.try_mark_completed()) {
+                    new (state.value.get()) util::types::monostate_if_void<output_type>{std::move(value)};
+                    notify();
+                }
+            }
+        } catch (...) {
+            if (state.try_mark_completed()) {
+                state.e_ptr = std::current_exception();
+                notify();
+            }
+        }
+    }
+
     core::cancel_source &get_cancel_source() noexcept { return this->m_state->cancel_source; }
 
     output_type await() {
@@ -263,7 +401,7 @@ private:
         }
     }
 
-    std::shared_ptr<task_state> m_state;
+    state_ref m_state;
 };
 
 template<typename F>
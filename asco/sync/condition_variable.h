@@ -3,18 +3,20 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <concepts>
-#include <deque>
 #include <expected>
 #include <limits>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
 #include <asco/core/worker.h>
 #include <asco/future.h>
 #include <asco/join_handle.h>
-#include <asco/sync/spinlock.h>
+#include <asco/sync/ticket_spinlock.h>
 #include <asco/yield.h>
 
 namespace asco::sync {
@@ -24,6 +26,8 @@ enum class notify_failed {
     no_waiters,
 };
 
+// 等待者节点位于等待中的协程帧内，入队与唤醒不分配内存
+// 唤醒时只在锁内摘下节点并复制 token ，释放锁之后才调用 awake_token::awake()
 class condition_variable final {
 public:
     condition_variable() = default;
@@ -37,14 +41,18 @@ public:
     template<std::invocable<> Fn>
         requires(!async_function<Fn> && !spawned_function<Fn> && std::same_as<std::invoke_result_t<Fn>, bool>)
     future<void> wait(Fn predictor) {
+        waiter w{this};
         while (true) {
-            if (auto g = m_wait_queue.lock()) {
+            if (auto g = m_lock.lock()) {
                 if (predictor()) {
                     co_return;
                 }
-                core::awake_token token{};
-                g->push_back(token);
-                token.suspend();
+                if (!w.queued.load(std::memory_order::relaxed)) {
+                    enqueue(w);
+                }
+                // 让出期间任务可能被迁移到其它 worker ，节点留在协程帧中，token 按当前 worker 重建
+                w.token = core::awake_token{};
+                w.token.suspend();
             }
             co_await this_task::yield();
         }
@@ -54,82 +62,51 @@ public:
     template<std::invocable<> Fn>
         requires(!async_function<Fn> && !spawned_function<Fn> && std::same_as<std::invoke_result_t<Fn>, bool>)
     future<bool> wait_once(Fn predicator) {
-        if (auto g = m_wait_queue.lock()) {
+        waiter w{this};
+        if (auto g = m_lock.lock()) {
             if (predicator()) {
                 co_return false;
             }
-            core::awake_token token{};
-            g->push_back(token);
-            token.suspend();
+            enqueue(w);
+            w.token.suspend();
         }
         co_await this_task::yield();
         co_return true;
     }
 
-    bool notify_one() {
-        auto g = m_wait_queue.lock();
-        if (g->empty()) {
-            return false;
-        }
-
-        auto &token = g->front();
-        token.awake();
-        g->pop_front();
-
-        return true;
-    }
+    bool notify_one() { return wake(m_lock.lock(), 1) != 0; }
 
     template<std::invocable<> Fn>
         requires(!async_function<Fn> && !spawned_function<Fn> && std::same_as<std::invoke_result_t<Fn>, bool>)
     std::expected<void, notify_failed> notify_one(Fn &&predicator) {
-        auto g = m_wait_queue.lock();
-        if (g->empty()) {
+        auto g = m_lock.lock();
+        if (!m_head) {
             return std::unexpected{notify_failed::no_waiters};
         }
         if (!predicator()) {
             return std::unexpected{notify_failed::predicate_false};
         }
 
-        auto &token = g->front();
-        token.awake();
-        g->pop_front();
-
+        wake(std::move(g), 1);
         return {};
     }
 
-    std::size_t notify(std::size_t n) {
-        auto g = m_wait_queue.lock();
-        std::size_t notified = 0;
-        while (!g->empty() && notified < n) {
-            auto &token = g->front();
-            token.awake();
-            g->pop_front();
-            ++notified;
-        }
-        return notified;
-    }
+    std::size_t notify(std::size_t n) { return wake(m_lock.lock(), n); }
 
     std::size_t notify() { return notify(std::numeric_limits<std::size_t>::max()); }
 
     template<std::invocable<> Fn>
         requires(!async_function<Fn> && !spawned_function<Fn> && std::same_as<std::invoke_result_t<Fn>, bool>)
     std::expected<std::size_t, notify_failed> notify(Fn &&predicator, std::size_t n) {
-        auto g = m_wait_queue.lock();
-        if (g->empty()) {
+        auto g = m_lock.lock();
+        if (!m_head) {
             return std::unexpected{notify_failed::no_waiters};
         }
         if (!predicator()) {
             return std::unexpected{notify_failed::predicate_false};
         }
 
-        std::size_t notified = 0;
-        while (!g->empty() && notified < n) {
-            auto &token = g->front();
-            token.awake();
-            g->pop_front();
-            ++notified;
-        }
-        return notified;
+        return wake(std::move(g), n);
     }
 
     template<std::invocable<> Fn>
@@ -139,7 +116,80 @@ public:
     }
 
 private:
-    spinlock<std::deque<core::awake_token>> m_wait_queue;
+    // 每次持锁最多摘下的等待者数量，唤醒大量等待者时分批释放锁
+    static constexpr std::size_t wake_batch = 16;
+
+    // 任务在等待时被取消，协程帧销毁时把节点移出队列
+    struct waiter {
+        condition_variable *cv;
+        core::awake_token token{};
+        waiter *prev{nullptr};
+        waiter *next{nullptr};
+        std::size_t seq{0};
+        std::atomic_bool queued{false};
+
+        explicit waiter(condition_variable *c) noexcept
+                : cv{c} {}
+
+        ~waiter() {
+            if (!queued.load(std::memory_order::acquire)) {
+                return;
+            }
+            auto g = cv->m_lock.lock();
+            if (queued.load(std::memory_order::relaxed)) {
+                cv->unlink(this);
+            }
+        }
+    };
+
+    void enqueue(waiter &w) noexcept {
+        w.seq = m_next_seq++;
+        w.prev = m_tail;
+        (m_tail ? m_tail->next : m_head) = &w;
+        m_tail = &w;
+        w.queued.store(true, std::memory_order::relaxed);
+    }
+
+    void unlink(waiter *w) noexcept {
+        (w->prev ? w->prev->next : m_head) = w->next;
+        (w->next ? w->next->prev : m_tail) = w->prev;
+        w->prev = w->next = nullptr;
+        w->queued.store(false, std::memory_order::release);
+    }
+
+    // 唤醒至多 n 个在调用时已入队的等待者，g 持有 m_lock
+    // 被摘下的节点所属的协程随时可能被唤醒并销毁节点，因此先复制 token ，释放锁后再唤醒
+    // 所有批次共用一个 awake_batch ，每个 worker 至多收到一次通知
+    std::size_t wake(ticket_spinlock<>::guard g, std::size_t n) {
+        const auto end = m_next_seq;
+        std::size_t woken = 0;
+        core::awake_batch batch;
+        while (true) {
+            std::array<std::optional<core::awake_token>, wake_batch> tokens;
+            std::size_t k = 0;
+            while (k < wake_batch && woken + k < n && m_head && m_head->seq < end) {
+                auto w = m_head;
+                tokens[k++] = w->token;
+                unlink(w);
+            }
+            bool more = k == wake_batch && woken + k < n && m_head && m_head->seq < end;
+            g = {};
+
+            for (std::size_t i = 0; i < k; ++i) {
+                batch.add(*tokens[i]);
+            }
+            woken += k;
+            if (!more) {
+                return woken;
+            }
+            g = m_lock.lock();
+        }
+    }
+
+    ticket_spinlock<> m_lock;
+    waiter *m_head{nullptr};
+    waiter *m_tail{nullptr};
+    std::size_t m_next_seq{0};
 };
 
 };  // namespace asco::sync
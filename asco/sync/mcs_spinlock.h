@@ -0,0 +1,276 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#ifdef ASCO_DEBUG_ENABLED
+#    include <thread>
+#endif
+
+#include <asco/concurrency/concurrency.h>
+#include <asco/panic.h>
+
+namespace asco::sync {
+
+template<typename T = void>
+class mcs_spinlock;
+
+// 基于队列的 FIFO 自旋锁（K42 形式的 MCS 锁）
+// 等待者在自己栈上的节点中自旋，每次交接只转移一条缓存行；
+// 持有者不需要节点，锁本身充当持有者的节点，因此 guard 可以自由移动
+template<>
+class mcs_spinlock<> final {
+    struct node {
+        std::atomic<node *> next{nullptr};
+        std::atomic_bool waiting{false};
+    };
+
+public:
+    class guard {
+        friend class mcs_spinlock;
+
+    public:
+        guard() = default;
+
+        ~guard() {
+            if (!m_lock) {
+                return;
+            }
+
+#ifdef ASCO_DEBUG_ENABLED
+            m_lock->m_locker_id = std::thread::id{};
+#endif
+            m_lock->unlock();
+        }
+
+        guard(const guard &) = delete;
+        guard &operator=(const guard &) = delete;
+
+        guard(guard &&rhs)
+                : m_lock{rhs.m_lock} {
+            rhs.m_lock = nullptr;
+        }
+
+        guard &operator=(guard &&rhs) {
+            if (this == &rhs) {
+                return *this;
+            }
+
+            this->~guard();
+            return *new (this) guard{std::move(rhs)};
+        }
+
+        operator bool() noexcept { return m_lock; }
+
+    private:
+        guard(mcs_spinlock *lock)
+                : m_lock{lock} {}
+
+        mcs_spinlock *m_lock{nullptr};
+    };
+
+    mcs_spinlock() = default;
+
+    ~mcs_spinlock() {
+        if (m_tail.load(std::memory_order::acquire)) {
+            panic("asco::sync::mcs_spinlock: 析构 mcs_spinlock 时依旧有线程持有锁");
+        }
+    }
+
+    mcs_spinlock(const mcs_spinlock &) = delete;
+    mcs_spinlock &operator=(const mcs_spinlock &) = delete;
+
+    mcs_spinlock(mcs_spinlock &&rhs) = delete;
+    mcs_spinlock &operator=(mcs_spinlock &&rhs) = delete;
+
+    guard lock() noexcept {
+        while (true) {
+            node *prev = m_tail.load(std::memory_order::relaxed);
+            if (!prev) {
+                if (m_tail.compare_exchange_weak(
+                        prev, &m_head, std::memory_order::acquire, std::memory_order::relaxed)) {
+                    break;
+                }
+                continue;
+            }
+
+            node n;
+            n.waiting.store(true, std::memory_order::relaxed);
+            if (!m_tail.compare_exchange_weak(
+                    prev, &n, std::memory_order::acq_rel, std::memory_order::relaxed)) {
+                continue;
+            }
+            prev->next.store(&n, std::memory_order::release);
+            std::size_t spins = 0;
+            while (n.waiting.load(std::memory_order::acquire)) {
+                concurrency::relax_or_yield(spins);
+            }
+
+            // 已取得锁，把后继转移到 m_head 后 n 即可失效
+            node *succ = n.next.load(std::memory_order::acquire);
+            if (!succ) {
+                m_head.next.store(nullptr, std::memory_order::relaxed);
+                node *expected = &n;
+                if (m_tail.compare_exchange_strong(
+                        expected, &m_head, std::memory_order::acq_rel, std::memory_order::relaxed)) {
+                    break;
+                }
+                while (!(succ = n.next.load(std::memory_order::acquire))) {
+                    concurrency::relax_or_yield(spins);
+                }
+            }
+            m_head.next.store(succ, std::memory_order::relaxed);
+            break;
+        }
+#ifdef ASCO_DEBUG_ENABLED
+        m_locker_id = std::this_thread::get_id();
+#endif
+        return {this};
+    }
+
+    guard try_lock() noexcept {
+        node *prev = nullptr;
+        if (m_tail.compare_exchange_strong(
+                prev, &m_head, std::memory_order::acquire, std::memory_order::relaxed)) {
+#ifdef ASCO_DEBUG_ENABLED
+            m_locker_id = std::this_thread::get_id();
+#endif
+            return {this};
+        } else {
+            return {};
+        }
+    }
+
+private:
+    void unlock() noexcept {
+        node *succ = m_head.next.load(std::memory_order::acquire);
+        if (!succ) {
+            node *expected = &m_head;
+            if (m_tail.compare_exchange_strong(
+                    expected, nullptr, std::memory_order::release, std::memory_order::relaxed)) {
+                return;
+            }
+            std::size_t spins = 0;
+            while (!(succ = m_head.next.load(std::memory_order::acquire))) {
+                concurrency::relax_or_yield(spins);
+            }
+        }
+        succ->waiting.store(false, std::memory_order::release);
+    }
+
+    // 空闲时 m_tail 为 nullptr ；无等待者的持有状态下指向 m_head
+    std::atomic<node *> m_tail{nullptr};
+    node m_head;
+#ifdef ASCO_DEBUG_ENABLED
+    std::thread::id m_locker_id;
+#endif
+};
+
+template<typename T>
+class mcs_spinlock final {
+public:
+    class guard {
+        friend class mcs_spinlock<T>;
+
+    public:
+        guard() = default;
+        ~guard() = default;
+
+        guard(const guard &) = delete;
+        guard &operator=(const guard &) = delete;
+
+        guard(guard &&rhs)
+                : m_lock{rhs.m_lock}
+                , m_guard{std::move(rhs.m_guard)} {
+            rhs.m_lock = nullptr;
+        }
+
+        guard &operator=(guard &&rhs) {
+            if (this == &rhs) {
+                return *this;
+            }
+
+            this->~guard();
+            return *new (this) guard{std::move(rhs)};
+        }
+
+        operator bool() const { return m_lock; }
+
+        const T &operator*() const {
+            if (!m_lock) {
+                panic("asco::sync::mcs_spinlock: 解引用失败，空的守卫");
+            }
+            return m_lock->m_value;
+        }
+
+        T &operator*() {
+            if (!m_lock) {
+                panic("asco::sync::mcs_spinlock: 解引用失败，空的守卫");
+            }
+            return m_lock->m_value;
+        }
+
+        const T *operator->() const {
+            if (!m_lock) {
+                panic("asco::sync::mcs_spinlock: 解引用失败，空的守卫");
+            }
+            return &m_lock->m_value;
+        }
+
+        T *operator->() {
+            if (!m_lock) {
+                panic("asco::sync::mcs_spinlock: 解引用失败，空的守卫");
+            }
+            return &m_lock->m_value;
+        }
+
+    private:
+        guard(mcs_spinlock *lock, mcs_spinlock<>::guard &&guard)
+                : m_lock{lock}
+                , m_guard{std::move(guard)} {}
+
+        mcs_spinlock *m_lock{nullptr};
+        mcs_spinlock<>::guard m_guard;
+    };
+
+    mcs_spinlock()
+        requires(!std::is_same_v<std::remove_cvref_t<T>, mcs_spinlock> && std::is_default_constructible_v<T>)
+    = default;
+
+    template<typename... Args>
+    mcs_spinlock(Args &&...args)
+        requires(!std::is_same_v<std::remove_cvref_t<T>, mcs_spinlock>)
+            : m_value{args...} {}
+
+    mcs_spinlock(T &&value)
+        requires(!std::is_same_v<std::remove_cvref_t<T>, mcs_spinlock> && std::is_move_constructible_v<T>)
+            : m_value{std::move(value)} {}
+
+    ~mcs_spinlock() = default;
+
+    mcs_spinlock(const mcs_spinlock &) = delete;
+    mcs_spinlock &operator=(const mcs_spinlock &) = delete;
+
+    mcs_spinlock(mcs_spinlock &&rhs) = delete;
+    mcs_spinlock &operator=(mcs_spinlock &&rhs) = delete;
+
+    guard lock() noexcept { return {this, m_lock.lock()}; }
+
+    guard try_lock() noexcept {
+        if (auto g = m_lock.try_lock()) {
+            return {this, std::move(g)};
+        } else {
+            return {};
+        }
+    }
+
+private:
+    T m_value;
+    mcs_spinlock<> m_lock;
+};
+
+};  // namespace asco::sync
@@ -3,23 +3,35 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
 #include <type_traits>
 #include <utility>
 #ifdef ASCO_DEBUG_ENABLED
 #    include <thread>
 #endif
 
+#include <asco/concurrency/concurrency.h>
 #include <asco/core/runtime.h>
+#include <asco/core/worker.h>
 #include <asco/future.h>
 #include <asco/panic.h>
-#include <asco/sync/semaphore.h>
+#include <asco/sync/ticket_spinlock.h>
 #include <asco/this_task.h>
+#include <asco/util/tsc.h>
+#include <asco/yield.h>
 
 namespace asco::sync {
 
 template<typename T = void>
 class mutex;
 
+// 基于等待队列的公平异步互斥锁
+// 锁空闲时任何任务都可以直接抢占；队首等待者等待超过 barging_window 后，unlock 把所有权直接移交给它，
+// 新来者不再能插队。加锁前根据观测到的平均持有时间决定是否先自旋等待
 template<>
 class mutex<> final {
 public:
@@ -34,10 +46,7 @@ public:
                 return;
             }
 
-#ifdef ASCO_DEBUG_ENABLED
-            m_lock->m_locker_id = std::thread::id{};
-#endif
-            m_lock->m_locked.release();
+            m_lock->unlock();
         }
 
         guard(const guard &) = delete;
@@ -66,10 +75,16 @@ public:
         mutex<> *m_lock{nullptr};
     };
 
+    // 队首等待者等待超过此时长后，unlock 直接移交所有权
+    static constexpr auto barging_window = std::chrono::microseconds{200};
+    // 平均持有时间（tsc 周期）不超过此值时才自旋，自旋时长为平均持有时间的两倍
+    static constexpr std::uint64_t max_spin_cycles = 4096;
+    static constexpr std::uint64_t min_spin_cycles = 256;
+
     mutex() = default;
 
     ~mutex() {
-        if (m_locked.get_count() == 0) {
+        if (m_state.load(std::memory_order::acquire) & locked_bit) {
             panic("asco::sync::mutex: 析构 mutex 时依旧有线程持有锁");
         }
     }
@@ -81,11 +96,39 @@ public:
     mutex &operator=(mutex &&rhs) = delete;
 
     future<guard> lock() {
-        co_await m_locked.acquire();
-#ifdef ASCO_DEBUG_ENABLED
-        m_locker_id = std::this_thread::get_id();
-#endif
-        co_return guard{this};
+        if (try_acquire()) {
+            co_return acquired();
+        }
+
+        if (auto budget = spin_budget()) {
+            auto deadline = util::get_tsc() + budget;
+            do {
+                concurrency::cpu_relax();
+                if (try_acquire()) {
+                    co_return acquired();
+                }
+            } while (util::get_tsc() < deadline);
+        }
+
+        waiter w{this};
+        while (true) {
+            {
+                auto g = m_queue_lock.lock();
+                // 被移交所有权时锁一直处于持有状态；被唤醒时锁已被释放，需要与新来者竞争
+                auto st = w.state.load(std::memory_order::relaxed);
+                if (st == waiter_state::owner) {
+                    w.state.store(waiter_state::done, std::memory_order::relaxed);
+                    co_return acquired();
+                }
+                if (st != waiter_state::queued && try_acquire_or_enqueue(w)) {
+                    co_return acquired();
+                }
+                // 让出期间任务可能被迁移到其它 worker ，每次挂起前按当前 worker 重建 token
+                w.token = core::awake_token{};
+                w.token.suspend();
+            }
+            co_await this_task::yield();
+        }
     }
 
     guard blocking_lock() {
@@ -96,18 +139,168 @@ public:
     }
 
     guard try_lock() noexcept {
-        if (m_locked.try_acquire()) {
-#ifdef ASCO_DEBUG_ENABLED
-            m_locker_id = std::this_thread::get_id();
-#endif
-            return guard{this};
+        if (try_acquire()) {
+            return acquired();
         } else {
             return {};
         }
     }
 
 private:
-    binary_semaphore m_locked{1};
+    static constexpr std::uint8_t locked_bit = 1;
+    static constexpr std::uint8_t waiters_bit = 2;
+
+    enum class waiter_state : std::uint8_t {
+        done,     // 不在队列中，也不持有被移交的所有权
+        queued,   // 在等待队列中
+        woken,    // 锁被释放后被唤醒，需要重新竞争
+        owner,    // unlock 已把所有权移交给它
+    };
+
+    // 位于 lock() 的协程帧中；任务在等待时被取消，协程帧销毁时把自己移出队列或归还已移交的锁
+    struct waiter {
+        mutex *lock;
+        core::awake_token token{};
+        waiter *prev{nullptr};
+        waiter *next{nullptr};
+        std::chrono::steady_clock::time_point since{};
+        std::atomic<waiter_state> state{waiter_state::done};
+
+        explicit waiter(mutex *m) noexcept
+                : lock{m} {}
+
+        ~waiter() {
+            if (state.load(std::memory_order::acquire) == waiter_state::done) {
+                return;
+            }
+            bool owned;
+            {
+                auto g = lock->m_queue_lock.lock();
+                auto s = state.load(std::memory_order::relaxed);
+                if (s == waiter_state::queued) {
+                    lock->unlink(this);
+                    if (!lock->m_head) {
+                        lock->m_state.fetch_and(~waiters_bit, std::memory_order::relaxed);
+                    }
+                }
+                owned = s == waiter_state::owner;
+            }
+            if (owned) {
+                lock->unlock();
+            }
+        }
+    };
+
+    bool try_acquire() noexcept {
+        auto s = m_state.load(std::memory_order::relaxed);
+        while (!(s & locked_bit)) {
+            if (m_state.compare_exchange_weak(
+                    s, s | locked_bit, std::memory_order::acquire, std::memory_order::relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 持有 m_queue_lock 时调用：锁空闲则取得锁，否则标记有等待者并入队
+    // 重新入队的等待者排在队首，保留首次入队的时间以便尽早触发所有权移交
+    bool try_acquire_or_enqueue(waiter &w) noexcept {
+        auto s = m_state.load(std::memory_order::relaxed);
+        while (true) {
+            if (!(s & locked_bit)) {
+                if (m_state.compare_exchange_weak(
+                        s, s | locked_bit, std::memory_order::acquire, std::memory_order::relaxed)) {
+                    w.state.store(waiter_state::done, std::memory_order::relaxed);
+                    return true;
+                }
+            } else if (m_state.compare_exchange_weak(
+                           s, s | waiters_bit, std::memory_order::relaxed, std::memory_order::relaxed)) {
+                break;
+            }
+        }
+
+        if (w.state.load(std::memory_order::relaxed) == waiter_state::woken) {
+            w.next = m_head;
+            (m_head ? m_head->prev : m_tail) = &w;
+            m_head = &w;
+        } else {
+            w.since = std::chrono::steady_clock::now();
+            w.prev = m_tail;
+            (m_tail ? m_tail->next : m_head) = &w;
+            m_tail = &w;
+        }
+        w.state.store(waiter_state::queued, std::memory_order::relaxed);
+        return false;
+    }
+
+    void unlink(waiter *w) noexcept {
+        (w->prev ? w->prev->next : m_head) = w->next;
+        (w->next ? w->next->prev : m_tail) = w->prev;
+        w->prev = w->next = nullptr;
+    }
+
+    guard acquired() noexcept {
+#ifdef ASCO_DEBUG_ENABLED
+        m_locker_id = std::this_thread::get_id();
+#endif
+        m_acquired_at = util::get_tsc();
+        return guard{this};
+    }
+
+    std::uint64_t spin_budget() const noexcept {
+        // 平均持有时间过长时自旋多半白费，直接挂起
+        auto hold = m_avg_hold.load(std::memory_order::relaxed);
+        return hold <= max_spin_cycles ? std::max(hold * 2, min_spin_cycles) : 0;
+    }
+
+    void unlock() noexcept {
+#ifdef ASCO_DEBUG_ENABLED
+        m_locker_id = std::thread::id{};
+#endif
+        // 只有持有者写入，以 1/8 的权重更新平均持有时间
+        auto hold = util::get_tsc() - m_acquired_at;
+        auto avg = m_avg_hold.load(std::memory_order::relaxed);
+        m_avg_hold.store(avg - avg / 8 + hold / 8, std::memory_order::relaxed);
+
+        auto s = locked_bit;
+        if (m_state.compare_exchange_strong(s, 0, std::memory_order::release, std::memory_order::relaxed)) {
+            return;
+        }
+
+        // unlock 可能发生在阻塞线程上，不能默认构造 awake_token
+        std::optional<core::awake_token> token;
+        {
+            auto g = m_queue_lock.lock();
+            auto w = m_head;
+            if (!w) {
+                m_state.fetch_and(~locked_bit, std::memory_order::release);
+                return;
+            }
+            unlink(w);
+            std::uint8_t clear = m_head ? 0 : waiters_bit;
+            token = w->token;
+            if (std::chrono::steady_clock::now() - w->since >= barging_window) {
+                // 锁保持持有状态，新来者无法插队
+                if (clear) {
+                    m_state.fetch_and(~clear, std::memory_order::relaxed);
+                }
+                w->state.store(waiter_state::owner, std::memory_order::release);
+            } else {
+                w->state.store(waiter_state::woken, std::memory_order::relaxed);
+                m_state.fetch_and(~(locked_bit | clear), std::memory_order::release);
+            }
+        }
+        // 被唤醒的等待者可能立即返回并销毁 waiter ，只使用复制出的 token
+        token->awake();
+    }
+
+    std::atomic_uint8_t m_state{0};
+    std::uint64_t m_acquired_at{0};
+    std::atomic_uint64_t m_avg_hold{0};
+
+    ticket_spinlock<> m_queue_lock;
+    waiter *m_head{nullptr};
+    waiter *m_tail{nullptr};
 #ifdef ASCO_DEBUG_ENABLED
     std::thread::id m_locker_id;
 #endif
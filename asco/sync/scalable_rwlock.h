@@ -0,0 +1,438 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <asco/core/worker.h>
+#include <asco/future.h>
+#include <asco/panic.h>
+#include <asco/sync/condition_variable.h>
+#include <asco/sync/rwlock.h>
+#include <asco/util/consts.h>
+#include <asco/util/tsc.h>
+#include <asco/yield.h>
+
+namespace asco::sync {
+
+template<typename T = void>
+class scalable_rwlock;
+
+// 读多写少场景下的 rwlock ，语义与 rwlock 相同
+// 偏向读者时，读者只修改所在 worker 对应的计数槽，不触碰共享的状态字
+// 写者先取得底层 rwlock 的写锁，再撤销偏向并等待各计数槽清零；
+// 撤销后一段时间（撤销耗时的 inhibit_factor 倍）内读者走底层 rwlock ，之后由读者重新开启偏向
+template<>
+class scalable_rwlock<> final {
+    static constexpr std::size_t reader_slots = 64;
+    static constexpr std::uint64_t inhibit_factor = 9;
+    // 写者撤销偏向后先让出这么多轮等待计数槽清零，仍未清零时挂起，由最后离开计数槽的读者唤醒
+    static constexpr std::size_t drain_yield_rounds = 16;
+
+    struct alignas(util::cacheline) reader_slot {
+        std::atomic_size_t readers{0};
+    };
+
+public:
+    class write_guard final {
+        friend class scalable_rwlock;
+
+    public:
+        write_guard() = default;
+
+        ~write_guard() = default;
+
+        write_guard(const write_guard &) = delete;
+        write_guard &operator=(const write_guard &) = delete;
+
+        write_guard(write_guard &&rhs) noexcept = default;
+        write_guard &operator=(write_guard &&rhs) noexcept = default;
+
+        operator bool() const noexcept { return static_cast<bool>(m_guard); }
+
+    private:
+        write_guard(rwlock<>::write_guard &&guard) noexcept
+                : m_guard{std::move(guard)} {}
+
+        rwlock<>::write_guard m_guard;
+    };
+
+    class read_guard final {
+        friend class scalable_rwlock;
+
+    public:
+        read_guard() = default;
+
+        ~read_guard() {
+            if (m_slot) {
+                m_rwlock->release_slot(*m_slot);
+            }
+        }
+
+        read_guard(const read_guard &) = delete;
+        read_guard &operator=(const read_guard &) = delete;
+
+        read_guard(read_guard &&rhs) noexcept
+                : m_rwlock{rhs.m_rwlock}
+                , m_slot{rhs.m_slot}
+                , m_guard{std::move(rhs.m_guard)} {
+            rhs.m_rwlock = nullptr;
+            rhs.m_slot = nullptr;
+        }
+        read_guard &operator=(read_guard &&rhs) noexcept {
+            if (this != &rhs) {
+                this->~read_guard();
+                new (this) read_guard{std::move(rhs)};
+            }
+            return *this;
+        }
+
+        operator bool() const noexcept { return m_rwlock != nullptr; }
+
+        // 经由计数槽持有的读锁先转为底层 rwlock 的读锁再升级，底层已有写者等待时升级失败
+        future<write_guard> upgrade(this read_guard self) {
+            if (!self.m_rwlock) {
+                co_return write_guard{};
+            }
+
+            auto rwlock = self.m_rwlock;
+            if (self.m_slot) {
+                auto guard = rwlock->m_lock.try_read();
+                rwlock->release_slot(*self.m_slot);
+                self.m_slot = nullptr;
+                if (!guard) {
+                    co_return write_guard{};
+                }
+                self.m_guard = std::move(guard);
+            }
+            self.m_rwlock = nullptr;
+
+            auto guard = co_await std::move(self.m_guard).upgrade();
+            if (!guard) {
+                co_return write_guard{};
+            }
+            co_await rwlock->revoke_bias();
+            co_return write_guard{std::move(guard)};
+        }
+
+    private:
+        read_guard(scalable_rwlock *p, reader_slot *slot) noexcept
+                : m_rwlock{p}
+                , m_slot{slot} {}
+
+        read_guard(scalable_rwlock *p, rwlock<>::read_guard &&guard) noexcept
+                : m_rwlock{p}
+                , m_guard{std::move(guard)} {}
+
+        scalable_rwlock *m_rwlock{nullptr};
+        reader_slot *m_slot{nullptr};
+        rwlock<>::read_guard m_guard;
+    };
+
+    scalable_rwlock() = default;
+
+    scalable_rwlock(const scalable_rwlock &) = delete;
+    scalable_rwlock &operator=(const scalable_rwlock &) = delete;
+
+    scalable_rwlock(scalable_rwlock &&) = delete;
+    scalable_rwlock &operator=(scalable_rwlock &&) = delete;
+
+    future<read_guard> read() {
+        if (auto g = try_read_biased()) {
+            co_return g;
+        }
+
+        auto guard = co_await m_lock.read();
+        maybe_rebias();
+        co_return read_guard{this, std::move(guard)};
+    }
+
+    read_guard try_read() noexcept {
+        if (auto g = try_read_biased()) {
+            return g;
+        }
+
+        if (auto guard = m_lock.try_read()) {
+            maybe_rebias();
+            return read_guard{this, std::move(guard)};
+        }
+        return read_guard{};
+    }
+
+    future<write_guard> write() {
+        auto guard = co_await m_lock.write();
+        co_await revoke_bias();
+        co_return write_guard{std::move(guard)};
+    }
+
+    write_guard try_write() noexcept {
+        auto guard = m_lock.try_write();
+        if (!guard) {
+            return write_guard{};
+        }
+        if (m_bias.load(std::memory_order::relaxed)) {
+            m_bias.store(false, std::memory_order::seq_cst);
+            if (!drained()) {
+                return write_guard{};
+            }
+        }
+        return write_guard{std::move(guard)};
+    }
+
+private:
+    static std::size_t slot_index() noexcept {
+        if (auto w = core::worker::try_current()) {
+            return w->id() % reader_slots;
+        }
+        return std::hash<std::thread::id>{}(std::this_thread::get_id()) % reader_slots;
+    }
+
+    // 先占用计数槽再检查偏向，与写者先撤销偏向再检查计数槽配对
+    read_guard try_read_biased() noexcept {
+        if (!m_bias.load(std::memory_order::relaxed)) {
+            return read_guard{};
+        }
+
+        auto &slot = m_slots[slot_index()];
+        slot.readers.fetch_add(1, std::memory_order::seq_cst);
+        if (m_bias.load(std::memory_order::seq_cst)) {
+            return read_guard{this, &slot};
+        }
+        release_slot(slot);
+        return read_guard{};
+    }
+
+    // 先离开计数槽再检查偏向，与写者先撤销偏向再检查计数槽配对：
+    // 要么写者看到计数槽已清零，要么这里看到偏向已撤销并唤醒可能挂起的写者
+    void release_slot(reader_slot &slot) noexcept {
+        if (slot.readers.fetch_sub(1, std::memory_order::seq_cst) == 1
+            && !m_bias.load(std::memory_order::seq_cst)) {
+            m_drained_cv.notify();
+        }
+    }
+
+    // 持有底层读锁时没有写者，可以安全地重新开启偏向
+    void maybe_rebias() noexcept {
+        if (!m_bias.load(std::memory_order::relaxed)
+            && util::get_tsc() >= m_inhibit_until.load(std::memory_order::relaxed)) {
+            m_bias.store(true, std::memory_order::release);
+        }
+    }
+
+    bool drained() const noexcept {
+        for (auto &slot : m_slots) {
+            if (slot.readers.load(std::memory_order::seq_cst)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 调用者持有底层写锁
+    future<void> revoke_bias() {
+        if (!m_bias.load(std::memory_order::relaxed)) {
+            co_return;
+        }
+
+        m_bias.store(false, std::memory_order::seq_cst);
+        auto start = util::get_tsc();
+        for (std::size_t i = 0; !drained(); ++i) {
+            if (i == drain_yield_rounds) {
+                co_await m_drained_cv.wait([this] { return drained(); });
+                break;
+            }
+            co_await this_task::yield();
+        }
+        auto now = util::get_tsc();
+        m_inhibit_until.store(now + (now - start) * inhibit_factor, std::memory_order::relaxed);
+    }
+
+    std::array<reader_slot, reader_slots> m_slots;
+    std::atomic_bool m_bias{true};
+    std::atomic_uint64_t m_inhibit_until{0};
+    rwlock<> m_lock;
+    condition_variable m_drained_cv;
+};
+
+template<typename T>
+class scalable_rwlock final {
+public:
+    class write_guard final {
+        friend class scalable_rwlock;
+        friend class read_guard;
+
+    public:
+        write_guard() = default;
+
+        ~write_guard() = default;
+
+        write_guard(const write_guard &) = delete;
+        write_guard &operator=(const write_guard &) = delete;
+
+        write_guard(write_guard &&rhs) noexcept
+                : m_rwlock{std::move(rhs.m_rwlock)}
+                , m_guard{std::move(rhs.m_guard)} {
+            rhs.m_rwlock = nullptr;
+        }
+        write_guard &operator=(write_guard &&rhs) noexcept {
+            if (this != &rhs) {
+                this->~write_guard();
+                new (this) write_guard{std::move(rhs)};
+            }
+            return *this;
+        }
+
+        operator bool() const noexcept { return m_rwlock != nullptr; }
+
+        const T &operator*() const {
+            if (!m_rwlock) {
+                panic("asco::sync::scalable_rwlock: 解引用失败，空的守卫");
+            }
+            return m_rwlock->m_value;
+        }
+
+        T &operator*() {
+            if (!m_rwlock) {
+                panic("asco::sync::scalable_rwlock: 解引用失败，空的守卫");
+            }
+            return m_rwlock->m_value;
+        }
+
+        const T *operator->() const {
+            if (!m_rwlock) {
+                panic("asco::sync::scalable_rwlock: 解引用失败，空的守卫");
+            }
+            return &m_rwlock->m_value;
+        }
+
+        T *operator->() {
+            if (!m_rwlock) {
+                panic("asco::sync::scalable_rwlock: 解引用失败，空的守卫");
+            }
+            return &m_rwlock->m_value;
+        }
+
+    private:
+        write_guard(scalable_rwlock *p, scalable_rwlock<>::write_guard &&guard) noexcept
+                : m_rwlock{p}
+                , m_guard{std::move(guard)} {}
+
+        scalable_rwlock *m_rwlock{nullptr};
+        scalable_rwlock<>::write_guard m_guard;
+    };
+
+    class read_guard final {
+        friend class scalable_rwlock;
+
+    public:
+        read_guard() = default;
+
+        ~read_guard() = default;
+
+        read_guard(const read_guard &) = delete;
+        read_guard &operator=(const read_guard &) = delete;
+
+        read_guard(read_guard &&rhs) noexcept
+                : m_rwlock{std::move(rhs.m_rwlock)}
+                , m_guard{std::move(rhs.m_guard)} {
+            rhs.m_rwlock = nullptr;
+        }
+        read_guard &operator=(read_guard &&rhs) noexcept {
+            if (this != &rhs) {
+                this->~read_guard();
+                new (this) read_guard{std::move(rhs)};
+            }
+            return *this;
+        }
+
+        operator bool() const noexcept { return m_rwlock != nullptr; }
+
+        future<write_guard> upgrade(this read_guard self) {
+            if (!self.m_rwlock) {
+                co_return write_guard{};
+            }
+
+            auto guard = co_await std::move(self.m_guard).upgrade();
+            auto rwlock = const_cast<scalable_rwlock *>(self.m_rwlock);
+            self.m_rwlock = nullptr;
+            if (!guard) {
+                co_return write_guard{};
+            }
+            co_return write_guard{rwlock, std::move(guard)};
+        }
+
+        const T &operator*() const {
+            if (!m_rwlock) {
+                panic("asco::sync::scalable_rwlock: 解引用失败，空的守卫");
+            }
+            return m_rwlock->m_value;
+        }
+
+        const T *operator->() const {
+            if (!m_rwlock) {
+                panic("asco::sync::scalable_rwlock: 解引用失败，空的守卫");
+            }
+            return &m_rwlock->m_value;
+        }
+
+    private:
+        read_guard(const scalable_rwlock *p, scalable_rwlock<>::read_guard &&guard) noexcept
+                : m_rwlock{p}
+                , m_guard{std::move(guard)} {}
+
+        const scalable_rwlock *m_rwlock{nullptr};
+        scalable_rwlock<>::read_guard m_guard;
+    };
+
+    scalable_rwlock()
+        requires(
+            !std::is_same_v<std::remove_cvref_t<T>, scalable_rwlock> && std::is_default_constructible_v<T>)
+    = default;
+
+    template<typename... Args>
+    scalable_rwlock(Args &&...args)
+        requires(!std::is_same_v<std::remove_cvref_t<T>, scalable_rwlock>)
+            : m_value{std::forward<Args>(args)...} {}
+
+    ~scalable_rwlock() = default;
+
+    scalable_rwlock(const scalable_rwlock &) = delete;
+    scalable_rwlock &operator=(const scalable_rwlock &) = delete;
+
+    scalable_rwlock(scalable_rwlock &&) = delete;
+    scalable_rwlock &operator=(scalable_rwlock &&) = delete;
+
+    future<read_guard> read() { co_return read_guard{this, co_await m_rwlock.read()}; }
+
+    read_guard try_read() {
+        if (auto guard = m_rwlock.try_read()) {
+            return read_guard{this, std::move(guard)};
+        } else {
+            return read_guard{};
+        }
+    }
+
+    future<write_guard> write() { co_return write_guard{this, co_await m_rwlock.write()}; }
+
+    write_guard try_write() {
+        if (auto guard = m_rwlock.try_write()) {
+            return write_guard{this, std::move(guard)};
+        } else {
+            return write_guard{};
+        }
+    }
+
+private:
+    T m_value;
+    scalable_rwlock<> m_rwlock;
+};
+
+};  // namespace asco::sync
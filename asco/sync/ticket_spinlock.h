@@ -0,0 +1,232 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#ifdef ASCO_DEBUG_ENABLED
+#    include <thread>
+#endif
+
+#include <asco/concurrency/concurrency.h>
+#include <asco/panic.h>
+
+namespace asco::sync {
+
+template<typename T = void>
+class ticket_spinlock;
+
+// FIFO 票据自旋锁，适合临界区很短的场景
+// 只占 8 字节；等待者按与队首的距离退避，减少对 m_serving 所在缓存行的争抢
+template<>
+class ticket_spinlock<> final {
+public:
+    class guard {
+        friend class ticket_spinlock;
+
+    public:
+        guard() = default;
+
+        ~guard() {
+            if (!m_lock) {
+                return;
+            }
+
+#ifdef ASCO_DEBUG_ENABLED
+            m_lock->m_locker_id = std::thread::id{};
+#endif
+            // 只有持有者会修改 m_serving
+            m_lock->m_serving.store(
+                m_lock->m_serving.load(std::memory_order::relaxed) + 1, std::memory_order::release);
+        }
+
+        guard(const guard &) = delete;
+        guard &operator=(const guard &) = delete;
+
+        guard(guard &&rhs)
+                : m_lock{rhs.m_lock} {
+            rhs.m_lock = nullptr;
+        }
+
+        guard &operator=(guard &&rhs) {
+            if (this == &rhs) {
+                return *this;
+            }
+
+            this->~guard();
+            return *new (this) guard{std::move(rhs)};
+        }
+
+        operator bool() noexcept { return m_lock; }
+
+    private:
+        guard(ticket_spinlock *lock)
+                : m_lock{lock} {}
+
+        ticket_spinlock *m_lock{nullptr};
+    };
+
+    ticket_spinlock() = default;
+
+    ~ticket_spinlock() {
+        if (m_next.load(std::memory_order::acquire) != m_serving.load(std::memory_order::acquire)) {
+            panic("asco::sync::ticket_spinlock: 析构 ticket_spinlock 时依旧有线程持有锁");
+        }
+    }
+
+    ticket_spinlock(const ticket_spinlock &) = delete;
+    ticket_spinlock &operator=(const ticket_spinlock &) = delete;
+
+    ticket_spinlock(ticket_spinlock &&rhs) = delete;
+    ticket_spinlock &operator=(ticket_spinlock &&rhs) = delete;
+
+    guard lock() noexcept {
+        auto ticket = m_next.fetch_add(1, std::memory_order::relaxed);
+        std::size_t spins = 0;
+        while (true) {
+            auto serving = m_serving.load(std::memory_order::acquire);
+            if (serving == ticket) {
+                break;
+            }
+            for (std::uint32_t i = (ticket - serving) * backoff_per_waiter; i; i--) {
+                concurrency::relax_or_yield(spins);
+            }
+        }
+#ifdef ASCO_DEBUG_ENABLED
+        m_locker_id = std::this_thread::get_id();
+#endif
+        return {this};
+    }
+
+    guard try_lock() noexcept {
+        auto serving = m_serving.load(std::memory_order::acquire);
+        if (m_next.compare_exchange_strong(
+                serving, serving + 1, std::memory_order::acquire, std::memory_order::relaxed)) {
+#ifdef ASCO_DEBUG_ENABLED
+            m_locker_id = std::this_thread::get_id();
+#endif
+            return {this};
+        } else {
+            return {};
+        }
+    }
+
+private:
+    static constexpr std::uint32_t backoff_per_waiter = 8;
+
+    std::atomic_uint32_t m_next{0};
+    std::atomic_uint32_t m_serving{0};
+#ifdef ASCO_DEBUG_ENABLED
+    std::thread::id m_locker_id;
+#endif
+};
+
+template<typename T>
+class ticket_spinlock final {
+public:
+    class guard {
+        friend class ticket_spinlock<T>;
+
+    public:
+        guard() = default;
+        ~guard() = default;
+
+        guard(const guard &) = delete;
+        guard &operator=(const guard &) = delete;
+
+        guard(guard &&rhs)
+                : m_lock{rhs.m_lock}
+                , m_guard{std::move(rhs.m_guard)} {
+            rhs.m_lock = nullptr;
+        }
+
+        guard &operator=(guard &&rhs) {
+            if (this == &rhs) {
+                return *this;
+            }
+
+            this->~guard();
+            return *new (this) guard{std::move(rhs)};
+        }
+
+        operator bool() const { return m_lock; }
+
+        const T &operator*() const {
+            if (!m_lock) {
+                panic("asco::sync::ticket_spinlock: 解引用失败，空的守卫");
+            }
+            return m_lock->m_value;
+        }
+
+        T &operator*() {
+            if (!m_lock) {
+                panic("asco::sync::ticket_spinlock: 解引用失败，空的守卫");
+            }
+            return m_lock->m_value;
+        }
+
+        const T *operator->() const {
+            if (!m_lock) {
+                panic("asco::sync::ticket_spinlock: 解引用失败，空的守卫");
+            }
+            return &m_lock->m_value;
+        }
+
+        T *operator->() {
+            if (!m_lock) {
+                panic("asco::sync::ticket_spinlock: 解引用失败，空的守卫");
+            }
+            return &m_lock->m_value;
+        }
+
+    private:
+        guard(ticket_spinlock *lock, ticket_spinlock<>::guard &&guard)
+                : m_lock{lock}
+                , m_guard{std::move(guard)} {}
+
+        ticket_spinlock *m_lock{nullptr};
+        ticket_spinlock<>::guard m_guard;
+    };
+
+    ticket_spinlock()
+        requires(
+            !std::is_same_v<std::remove_cvref_t<T>, ticket_spinlock> && std::is_default_constructible_v<T>)
+    = default;
+
+    template<typename... Args>
+    ticket_spinlock(Args &&...args)
+        requires(!std::is_same_v<std::remove_cvref_t<T>, ticket_spinlock>)
+            : m_value{args...} {}
+
+    ticket_spinlock(T &&value)
+        requires(!std::is_same_v<std::remove_cvref_t<T>, ticket_spinlock> && std::is_move_constructible_v<T>)
+            : m_value{std::move(value)} {}
+
+    ~ticket_spinlock() = default;
+
+    ticket_spinlock(const ticket_spinlock &) = delete;
+    ticket_spinlock &operator=(const ticket_spinlock &) = delete;
+
+    ticket_spinlock(ticket_spinlock &&rhs) = delete;
+    ticket_spinlock &operator=(ticket_spinlock &&rhs) = delete;
+
+    guard lock() noexcept { return {this, m_lock.lock()}; }
+
+    guard try_lock() noexcept {
+        if (auto g = m_lock.try_lock()) {
+            return {this, std::move(g)};
+        } else {
+            return {};
+        }
+    }
+
+private:
+    T m_value;
+    ticket_spinlock<> m_lock;
+};
+
+};  // namespace asco::sync
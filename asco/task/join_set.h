@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <concepts>
 #include <optional>
+#include <ranges>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -53,6 +54,27 @@ public:
         m_task_count.fetch_add(1, std::memory_order::acq_rel);
     }
 
+    // 一次提交一组异步函数，结果同样按完成顺序通过 co_await set 收集
+    template<std::ranges::input_range Range>
+        requires(std::ranges::sized_range<Range> && async_function<std::ranges::range_reference_t<Range>>)
+    void spawn_many(Range &&range) {
+        auto n = static_cast<std::size_t>(std::ranges::size(range));
+        m_runtime
+            .spawn_many(
+                std::forward<Range>(range) | std::views::transform([this](auto &&fn) {
+                    return [tx = m_tx, fn = std::forward<decltype(fn)>(fn)]() mutable -> future<void> {
+                        if constexpr (std::is_void_v<output_type>) {
+                            co_await co_invoke(fn);
+                            co_await tx.send();
+                        } else {
+                            co_await tx.send(co_await co_invoke(fn));
+                        }
+                    };
+                }))
+            .detach();
+        m_task_count.fetch_add(n, std::memory_order::acq_rel);
+    }
+
     void spawn_blocking(std::invocable<> auto &&fn)
         requires(!async_function<decltype(fn)>)
     {
@@ -3,6 +3,7 @@
 
 #include <asco/this_task.h>
 
+#include <asco/core/blocking_pool.h>
 #include <asco/core/runtime.h>
 #include <asco/core/worker.h>
 #include <asco/panic.h>
@@ -10,6 +11,9 @@
 namespace asco::this_task {
 
 core::cancel_token &get_current_cancel_token() noexcept {
+    if (auto job = core::blocking_pool::current_job()) {
+        return job->token;
+    }
     if (!in_runtime()) {
         panic("asco::this_task::get_current_cancel_token: 不在 runtime 中");
     }
@@ -21,13 +25,29 @@ core::cancel_token &get_current_cancel_token() noexcept {
     }
 }
 
-bool is_blocking_env() noexcept {
-    if (!in_runtime()) {
-        return true;
+core::mm::task_arena &arena() noexcept {
+    core::mm::task_arena::handle *slot = nullptr;
+    if (auto job = core::blocking_pool::current_job()) {
+        slot = &job->arena;
+    } else {
+        if (!in_runtime()) {
+            panic("asco::this_task::arena: 不在 runtime 中");
+        }
+        auto exec = core::worker::current().get_executor().current_execution_record();
+        if (!exec || !exec->task_meta) {
+            panic("asco::this_task::arena: 当前没有正在运行的任务");
+        }
+        slot = &static_cast<core::detail::coroutine_meta *>(exec->task_meta)->arena;
     }
-
-    auto &w = core::worker::current();
-    return w.m_coroutine_metas.get(w.get_executor().current_execution()).value().blocking;
+    if (!*slot) {
+        *slot = core::mm::task_arena::create();
+        if (!*slot) {
+            panic("asco::this_task::arena: 分配区内存分配失败");
+        }
+    }
+    return **slot;
 }
 
+bool is_blocking_env() noexcept { return core::worker::try_current() == nullptr; }
+
 };  // namespace asco::this_task
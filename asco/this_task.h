@@ -4,6 +4,7 @@
 #pragma once
 
 #include <asco/core/cancellation.h>
+#include <asco/core/mm/task_arena.h>
 
 namespace asco::this_task {
 
@@ -14,6 +15,10 @@ TaskLocalStorage &task_local() noexcept;
 
 bool is_blocking_env() noexcept;
 
+// 当前任务的 bump 分配区，首次调用时创建，任务结束时整体释放
+// join_all 等子执行域中的分支与所在任务共享同一个分配区
+core::mm::task_arena &arena() noexcept;
+
 };  // namespace asco::this_task
 
 // task_local 的实现在此头文件中
@@ -3,12 +3,15 @@
 
 #pragma once
 
+#include <cstddef>
 #include <new>
+#include <type_traits>
 #include <utility>
 
 namespace asco::util {
 
 // 无类型安全保证的类型擦除容器
+// 小的、不抛异常可移动的对象直接存放在容器内部，移动容器时对象随之搬移；其它对象放在堆上
 class erased final {
 public:
     template<typename T>
@@ -16,31 +19,55 @@ public:
         T &v;
     };
 
+    static constexpr std::size_t inline_size = 48;
+    static constexpr std::size_t inline_align = alignof(std::max_align_t);
+
+    template<typename T>
+    static constexpr bool stored_inline = sizeof(T) <= inline_size && alignof(T) <= inline_align
+                                          && std::is_nothrow_move_constructible_v<T>;
+
+    // 外部存储的默认分配器
+    struct heap_allocator {
+        static void *allocate(std::size_t size, std::size_t align) noexcept {
+            return ::operator new(size, std::align_val_t{align});
+        }
+
+        static void deallocate(void *ptr, std::size_t size, std::size_t align) noexcept {
+            ::operator delete(ptr, size, std::align_val_t{align});
+        }
+    };
+
     erased() = default;
 
     template<typename T>
-    erased(T &&value) noexcept
-            : m_align{alignof(T)}
-            , m_storage(::operator new(sizeof(T), std::align_val_t{alignof(T)}))
-            , m_deleter(default_deleter<T>) {
-        new (m_storage) T(std::move(value));
+        requires(!std::is_same_v<std::remove_cvref_t<T>, erased>)
+    erased(T &&value) noexcept {
+        using value_type = std::remove_cvref_t<T>;
+        if constexpr (stored_inline<value_type>) {
+            m_storage = new (m_inline) value_type(std::forward<T>(value));
+            m_ops = &inline_ops<value_type>;
+        } else {
+            emplace_outline<value_type, heap_allocator>(std::forward<T>(value));
+        }
     }
 
     template<typename T>
     erased(ref<T> &&value) noexcept
-            : m_align{alignof(T)}
-            , m_storage{&value.v}
-            , m_deleter{nullptr} {}
+            : m_storage{&value.v} {}
 
     erased(const erased &) = delete;
     erased &operator=(const erased &) = delete;
 
     erased(erased &&rhs) noexcept
-            : m_align{rhs.m_align}
-            , m_storage{rhs.m_storage}
-            , m_deleter{rhs.m_deleter} {
+            : m_ops{rhs.m_ops} {
+        if (rhs.is_inline()) {
+            m_storage = m_inline;
+            m_ops->relocate(rhs.m_inline, m_inline);
+        } else {
+            m_storage = rhs.m_storage;
+        }
         rhs.m_storage = nullptr;
-        rhs.m_deleter = nullptr;
+        rhs.m_ops = nullptr;
     }
 
     erased &operator=(erased &&rhs) noexcept {
@@ -53,32 +80,106 @@ public:
 
     template<typename T>
     T &get() noexcept {
-        return *reinterpret_cast<T *>(m_storage);
+        return *std::launder(reinterpret_cast<T *>(m_storage));
     }
 
     template<typename T>
     const T &get() const noexcept {
-        return *reinterpret_cast<const T *>(m_storage);
+        return *std::launder(reinterpret_cast<const T *>(m_storage));
     }
 
     ~erased() {
-        if (m_storage) {
-            if (m_deleter) {
-                m_deleter(m_storage);
-                ::operator delete(m_storage, m_align);
-            }
+        if (m_storage && m_ops) {
+            m_ops->destroy(m_storage);
         }
     }
 
 private:
+    struct operations {
+        // 析构对象，外部存储时一并释放
+        void (*destroy)(void *ptr) noexcept;
+        // 仅内联存储：把对象移动构造到 to 并析构 from
+        void (*relocate)(void *from, void *to) noexcept;
+    };
+
+    template<typename T>
+    static constexpr operations inline_ops{
+        [](void *ptr) noexcept { static_cast<T *>(ptr)->~T(); },
+        [](void *from, void *to) noexcept {
+            new (to) T(std::move(*static_cast<T *>(from)));
+            static_cast<T *>(from)->~T();
+        }};
+
+    template<typename T, typename Allocator>
+    static constexpr operations outline_ops{
+        [](void *ptr) noexcept {
+            static_cast<T *>(ptr)->~T();
+            Allocator::deallocate(ptr, sizeof(T), alignof(T));
+        },
+        nullptr};
+
+    template<typename T, typename Allocator, typename U>
+    void emplace_outline(U &&value) noexcept {
+        m_storage = new (Allocator::allocate(sizeof(T), alignof(T))) T(std::forward<U>(value));
+        m_ops = &outline_ops<T, Allocator>;
+    }
+
+    bool is_inline() const noexcept { return m_storage == m_inline; }
+
+    alignas(inline_align) unsigned char m_inline[inline_size];
+    void *m_storage{nullptr};
+    const operations *m_ops{nullptr};  // 引用其它对象时为 nullptr
+};
+
+// 外部存储中的类型擦除对象的独占所有者，只占两个指针
+// 对象总是放在由 Allocator 分配的外部存储中，移动 boxed 之后地址保持不变
+// 用于会被其它对象按地址引用的值，例如被协程按引用持有的闭包
+class boxed final {
+public:
+    boxed() = default;
+
+    template<typename Allocator = erased::heap_allocator, typename T>
+    static boxed make(T &&value) noexcept {
+        using value_type = std::remove_cvref_t<T>;
+        boxed b;
+        b.m_storage = new (Allocator::allocate(sizeof(value_type), alignof(value_type)))
+            value_type(std::forward<T>(value));
+        b.m_destroy = [](void *ptr) noexcept {
+            static_cast<value_type *>(ptr)->~value_type();
+            Allocator::deallocate(ptr, sizeof(value_type), alignof(value_type));
+        };
+        return b;
+    }
+
+    boxed(const boxed &) = delete;
+    boxed &operator=(const boxed &) = delete;
+
+    boxed(boxed &&rhs) noexcept
+            : m_storage{std::exchange(rhs.m_storage, nullptr)}
+            , m_destroy{std::exchange(rhs.m_destroy, nullptr)} {}
+
+    boxed &operator=(boxed &&rhs) noexcept {
+        if (this != &rhs) {
+            this->~boxed();
+            new (this) boxed(std::move(rhs));
+        }
+        return *this;
+    }
+
     template<typename T>
-    static void default_deleter(void *ptr) {
-        reinterpret_cast<T *>(ptr)->~T();
+    T &get() noexcept {
+        return *static_cast<T *>(m_storage);
     }
 
-    std::align_val_t m_align;
+    ~boxed() {
+        if (m_storage) {
+            m_destroy(m_storage);
+        }
+    }
+
+private:
     void *m_storage{nullptr};
-    void (*m_deleter)(void *){nullptr};
+    void (*m_destroy)(void *) noexcept {nullptr};
 };
 
 };  // namespace asco::util
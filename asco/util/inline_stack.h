@@ -0,0 +1,74 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <span>
+#include <utility>
+
+#include <asco/panic.h>
+
+namespace asco::util {
+
+// 容量固定、元素就地存放的栈，push 与 pop 永远不分配堆内存
+template<typename T, std::size_t N>
+class inline_stack {
+public:
+    inline_stack() = default;
+    ~inline_stack() { clear(); }
+
+    inline_stack(const inline_stack &) = delete;
+    inline_stack &operator=(const inline_stack &) = delete;
+
+    inline_stack(inline_stack &&) = delete;
+    inline_stack &operator=(inline_stack &&) = delete;
+
+    void push_back(T value) noexcept {
+        if (m_size == N) {
+            panic("asco::util::inline_stack: 超出容量 {}", N);
+        }
+        new (data() + m_size) T{std::move(value)};
+        ++m_size;
+    }
+
+    void pop_back() noexcept {
+        asco_assert(m_size);
+        --m_size;
+        data()[m_size].~T();
+    }
+
+    void clear() noexcept {
+        while (m_size) {
+            pop_back();
+        }
+    }
+
+    T &back() noexcept { return data()[m_size - 1]; }
+    const T &back() const noexcept { return data()[m_size - 1]; }
+
+    T &operator[](std::size_t i) noexcept { return data()[i]; }
+    const T &operator[](std::size_t i) const noexcept { return data()[i]; }
+
+    std::size_t size() const noexcept { return m_size; }
+    bool empty() const noexcept { return !m_size; }
+    static constexpr std::size_t capacity() noexcept { return N; }
+
+    T *begin() noexcept { return data(); }
+    T *end() noexcept { return data() + m_size; }
+    const T *begin() const noexcept { return data(); }
+    const T *end() const noexcept { return data() + m_size; }
+
+    std::span<T> span() noexcept { return {data(), m_size}; }
+    std::span<const T> span() const noexcept { return {data(), m_size}; }
+
+private:
+    T *data() noexcept { return std::launder(reinterpret_cast<T *>(m_storage)); }
+    const T *data() const noexcept { return std::launder(reinterpret_cast<const T *>(m_storage)); }
+
+    alignas(alignof(T)) unsigned char m_storage[sizeof(T) * N];
+    std::size_t m_size{0};
+};
+
+};  // namespace asco::util
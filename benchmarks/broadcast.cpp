@@ -0,0 +1,98 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <print>
+#include <ranges>
+#include <string_view>
+#include <thread>
+
+#include <asco/core/runtime.h>
+#include <asco/future.h>
+#include <asco/join_group.h>
+#include <asco/panic.h>
+#include <asco/sync/condition_variable.h>
+#include <asco/test/bench.h>
+#include <asco/yield.h>
+
+namespace {
+
+using asco::future;
+
+constexpr std::size_t waiters = 10'000;
+
+// 每一轮 waiters 个任务阻塞在同一个 condition_variable 上，计时从通知开始到所有任务恢复运行
+// batched 为 true 时调用一次 notify() 成批唤醒，否则逐个调用 notify_one() ，每个等待者单独通知其 worker
+future<void> bench_broadcast(std::string_view name, bool batched, std::size_t warmup, std::size_t measure) {
+    asco::test::bench_context bench{name, warmup, measure};
+
+    for (std::size_t round = 0; round < warmup + measure; ++round) {
+        asco::sync::condition_variable cv;
+        std::atomic_bool ready{false};
+        std::atomic_size_t queued{0};
+        std::atomic_size_t resumed{0};
+
+        auto group = asco::spawn_many(
+            std::views::iota(std::size_t{0}, waiters) | std::views::transform([&](std::size_t) {
+                return [&]() -> future<void> {
+                    co_await cv.wait([&] {
+                        if (ready.load(std::memory_order::acquire)) {
+                            return true;
+                        }
+                        queued.fetch_add(1, std::memory_order::relaxed);
+                        return false;
+                    });
+                    resumed.fetch_add(1, std::memory_order::release);
+                };
+            }));
+        while (queued.load(std::memory_order::relaxed) < waiters) {
+            co_await asco::this_task::yield();
+        }
+
+        ready.store(true, std::memory_order::release);
+        auto head = bench.get_span();
+        std::size_t notified = 0;
+        if (batched) {
+            notified = cv.notify();
+        } else {
+            while (cv.notify_one()) {
+                ++notified;
+            }
+        }
+        while (resumed.load(std::memory_order::acquire) < waiters) {
+            co_await asco::this_task::yield();
+        }
+        bench.commit(head);
+
+        co_await group.join_all();
+        if (notified != waiters) {
+            asco::panic("bench_broadcast: 通知数量错误：{}", notified);
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    using namespace asco;
+
+    std::size_t nthreads =
+        std::min<std::size_t>(4, std::max<std::size_t>(1, std::thread::hardware_concurrency()));
+    core::runtime rt = core::runtime_builder::multi_threaded(nthreads).build();
+
+    constexpr std::size_t warmup = 3;
+    constexpr std::size_t measure = 30;
+
+    try {
+        rt.block_on([&]() -> future<void> {
+            co_await bench_broadcast("broadcast_notify_one", false, warmup, measure);
+            co_await bench_broadcast("broadcast_notify_all", true, warmup, measure);
+        });
+        return 0;
+    } catch (...) {
+        std::println("unknown exception");
+        return 1;
+    }
+}
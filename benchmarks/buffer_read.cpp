@@ -0,0 +1,136 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <print>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <asco/core/mm/buffer_pool.h>
+#include <asco/core/mm/pool.h>
+#include <asco/core/runtime.h>
+#include <asco/future.h>
+#include <asco/io/buffer.h>
+#include <asco/io/file.h>
+#include <asco/join_group.h>
+#include <asco/panic.h>
+#include <asco/test/bench.h>
+
+namespace {
+
+using asco::future;
+
+constexpr std::size_t read_size = 4096;
+constexpr std::size_t ops_per_task = 64;
+
+// 每个样本中 tasks 个任务并发地分配并释放 io::buffer，对比原先进程共享的
+// synchronized_pool_resource 与每个线程独立的 buffer_pool
+future<void> bench_buffer_alloc(
+    std::string_view name, std::pmr::polymorphic_allocator<> &allocator, std::size_t tasks,
+    std::size_t warmup, std::size_t measure) {
+    asco::test::bench_context bench{name, warmup, measure};
+
+    for (std::size_t round = 0; round < warmup + measure; ++round) {
+        auto head = bench.get_span();
+        auto group = asco::spawn_many(
+            std::views::iota(std::size_t{0}, tasks) | std::views::transform([&](std::size_t) {
+                return [&]() -> future<std::size_t> {
+                    std::size_t bytes = 0;
+                    for (std::size_t i = 0; i < ops_per_task; ++i) {
+                        asco::io::buffer<> buf{read_size, allocator};
+                        bytes += buf.size();
+                    }
+                    co_return bytes;
+                };
+            }));
+        std::size_t bytes = 0;
+        for (auto v : co_await group.join_all()) {
+            bytes += v;
+        }
+        bench.commit(head);
+        if (bytes != tasks * ops_per_task * read_size) {
+            asco::panic("bench_buffer_alloc: 结果错误：{}", bytes);
+        }
+    }
+}
+
+// 每个任务打开同一个文件并读取 ops_per_task 次，每次读取都分配新的 io::buffer
+future<void> bench_file_read(
+    std::string_view name, const std::filesystem::path &path, std::size_t tasks, std::size_t warmup,
+    std::size_t measure) {
+    asco::test::bench_context bench{name, warmup, measure};
+
+    for (std::size_t round = 0; round < warmup + measure; ++round) {
+        auto head = bench.get_span();
+        auto group = asco::spawn_many(
+            std::views::iota(std::size_t{0}, tasks) | std::views::transform([&](std::size_t) {
+                return [&]() -> future<std::size_t> {
+                    auto opened = co_await asco::io::file::at(path).open();
+                    if (!opened) {
+                        asco::panic("bench_file_read: 打开文件失败");
+                    }
+                    auto file = std::move(*opened);
+                    std::size_t bytes = 0;
+                    for (std::size_t i = 0; i < ops_per_task; ++i) {
+                        file.seek(0, asco::io::seek_mode::set);
+                        auto buf = co_await file.read(read_size);
+                        if (!buf) {
+                            asco::panic("bench_file_read: 读取失败");
+                        }
+                        bytes += buf->cursor();
+                    }
+                    co_return bytes;
+                };
+            }));
+        std::size_t bytes = 0;
+        for (auto v : co_await group.join_all()) {
+            bytes += v;
+        }
+        bench.commit(head);
+        if (bytes != tasks * ops_per_task * read_size) {
+            asco::panic("bench_file_read: 结果错误：{}", bytes);
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    using namespace asco;
+
+    core::runtime rt = core::runtime_builder::multi_threaded().with_io().build();
+
+    constexpr std::size_t warmup = 10;
+    constexpr std::size_t measure = 200;
+    constexpr std::size_t tasks = 256;
+
+    auto path = std::filesystem::temp_directory_path() / "asco_bench_buffer_read";
+    {
+        std::ofstream out{path, std::ios::binary | std::ios::trunc};
+        std::string data(read_size, 'x');
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    try {
+        rt.block_on([&]() -> future<void> {
+            co_await bench_buffer_alloc(
+                "buffer_alloc_synchronized_pool_256x64", core::mm::pmr::get<io::buffer<>>(), tasks,
+                warmup, measure);
+            co_await bench_buffer_alloc(
+                "buffer_alloc_buffer_pool_256x64", core::mm::buffer_pool::allocator(), tasks, warmup,
+                measure);
+            co_await bench_file_read("file_read_4k_256x64", path, tasks, warmup, measure);
+        });
+        std::filesystem::remove(path);
+        return 0;
+    } catch (...) {
+        std::filesystem::remove(path);
+        std::println("unknown exception");
+        return 1;
+    }
+}
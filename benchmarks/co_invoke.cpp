@@ -0,0 +1,92 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <array>
+#include <cstddef>
+#include <print>
+#include <string_view>
+#include <utility>
+
+#include <asco/core/runtime.h>
+#include <asco/future.h>
+#include <asco/invoke.h>
+#include <asco/panic.h>
+#include <asco/test/bench.h>
+#include <asco/util/erased.h>
+
+namespace {
+
+using asco::future;
+
+// 每个样本中的调用次数
+constexpr std::size_t calls_per_sample = 1'000;
+
+template<std::size_t CaptureSize>
+struct capture {
+    std::array<unsigned char, CaptureSize> bytes{};
+    std::size_t value{};
+};
+
+template<std::size_t CaptureSize>
+future<void> bench_co_invoke(std::string_view name, std::size_t warmup, std::size_t measure) {
+    asco::test::bench_context bench{name, warmup, measure};
+
+    for (std::size_t i = 0; i < warmup + measure; ++i) {
+        auto head = bench.get_span();
+        std::size_t sum = 0;
+        for (std::size_t j = 0; j < calls_per_sample; ++j) {
+            capture<CaptureSize> c{.value = j};
+            sum += co_await asco::co_invoke([c]() -> future<std::size_t> { co_return c.value; });
+        }
+        bench.commit(head);
+        if (sum != calls_per_sample * (calls_per_sample - 1) / 2) {
+            asco::panic("bench_co_invoke: 结果错误：{}", sum);
+        }
+    }
+}
+
+// 构造并移动一次 erased，对比内联存储与堆存储
+template<std::size_t CaptureSize>
+void bench_erased(std::string_view name, std::size_t warmup, std::size_t measure) {
+    asco::test::bench_context bench{name, warmup, measure};
+
+    for (std::size_t i = 0; i < warmup + measure; ++i) {
+        auto head = bench.get_span();
+        std::size_t sum = 0;
+        for (std::size_t j = 0; j < calls_per_sample; ++j) {
+            asco::util::erased e{capture<CaptureSize>{.value = j}};
+            auto moved = std::move(e);
+            sum += moved.get<capture<CaptureSize>>().value;
+        }
+        bench.commit(head);
+        if (sum != calls_per_sample * (calls_per_sample - 1) / 2) {
+            asco::panic("bench_erased: 结果错误：{}", sum);
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    using namespace asco;
+
+    core::runtime rt = core::runtime_builder::single_threaded().build();
+
+    constexpr std::size_t warmup = 100;
+    constexpr std::size_t measure = 10'000;
+
+    // 16 字节的捕获可以内联存放在 erased 中，256 字节的捕获必须放在堆上
+    bench_erased<8>("erased_small_1k", warmup, measure);
+    bench_erased<248>("erased_large_1k", warmup, measure);
+
+    try {
+        rt.block_on([&]() -> future<void> {
+            co_await bench_co_invoke<8>("co_invoke_small_1k", warmup, measure);
+            co_await bench_co_invoke<248>("co_invoke_large_1k", warmup, measure);
+        });
+        return 0;
+    } catch (...) {
+        std::println("unknown exception");
+        return 1;
+    }
+}
@@ -0,0 +1,130 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <ranges>
+#include <string_view>
+#include <utility>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <asco/core/runtime.h>
+#include <asco/future.h>
+#include <asco/join_group.h>
+#include <asco/panic.h>
+#include <asco/yield.h>
+
+namespace {
+
+using asco::future;
+
+constexpr std::size_t fanout = 1'000'000;
+constexpr std::size_t rounds = 5;
+
+// 统计本进程及之后创建的 worker 线程的 dTLB 读缺失，不可用时返回 -1
+int open_dtlb_counter() noexcept {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                  | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+future<void> fan_out() {
+    auto group = asco::spawn_many(
+        std::views::iota(std::size_t{0}, fanout) | std::views::transform([](std::size_t i) {
+            return [i]() -> future<std::size_t> {
+                co_await asco::this_task::yield();
+                co_return i;
+            };
+        }));
+    std::size_t sum = 0;
+    for (auto v : co_await group.join_all()) {
+        sum += v;
+    }
+    if (sum != fanout * (fanout - 1) / 2) {
+        asco::panic("bench_huge_pages: 结果错误：{}", sum);
+    }
+}
+
+// 在子进程中运行：大页开关是进程级的，且每种模式都要从干净的堆开始
+int run(std::string_view name, bool huge_pages) {
+    using namespace asco;
+
+    auto counter = open_dtlb_counter();
+
+    core::runtime rt = core::runtime_builder::multi_threaded().with_huge_pages(huge_pages).build();
+
+    try {
+        // 第一轮用于预热协程池
+        rt.block_on([]() -> future<void> { co_await fan_out(); });
+
+        if (counter >= 0) {
+            ::ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < rounds; ++i) {
+            rt.block_on([]() -> future<void> { co_await fan_out(); });
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (counter >= 0) {
+            ::ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        }
+
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / rounds;
+        auto tasks_per_sec = static_cast<double>(fanout) * 1e9 / static_cast<double>(ns);
+
+        std::uint64_t misses = 0;
+        if (counter >= 0 && ::read(counter, &misses, sizeof(misses)) == sizeof(misses)) {
+            std::println(
+                "{}: {}ns per 1M fan-out, {:.0f} tasks/s, {} dTLB misses per fan-out",  //
+                name, ns, tasks_per_sec, misses / rounds);
+        } else {
+            std::println(
+                "{}: {}ns per 1M fan-out, {:.0f} tasks/s, dTLB misses unavailable", name, ns, tasks_per_sec);
+        }
+        return 0;
+    } catch (...) {
+        std::println("unknown exception");
+        return 1;
+    }
+}
+
+}  // namespace
+
+int main() {
+    constexpr std::pair<std::string_view, bool> modes[]{
+        {"fan_out_1m_4k_pages", false},
+        {"fan_out_1m_huge_pages", true},
+    };
+
+    for (auto [name, huge_pages] : modes) {
+        auto pid = ::fork();
+        if (pid < 0) {
+            std::println("fork failed");
+            return 1;
+        }
+        if (pid == 0) {
+            ::_exit(run(name, huge_pages));
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <print>
+#include <ranges>
+
+#ifdef __linux__
+#    include <unistd.h>
+#endif
+
+#include <asco/core/mm/coroutine_pool.h>
+#include <asco/core/runtime.h>
+#include <asco/future.h>
+#include <asco/join_group.h>
+#include <asco/panic.h>
+#include <asco/sync/channel.h>
+#include <asco/yield.h>
+
+namespace {
+
+using asco::future;
+
+constexpr std::size_t tasks = 1'000'000;
+
+// 所有线程的 coroutine_pool 中已分配出去的字节数：协程帧、join 状态与绑定的闭包
+std::size_t pool_bytes_in_use() {
+    std::size_t bytes = 0;
+    for (auto &o : asco::core::mm::coroutine_pool::occupancy_report()) {
+        for (auto &c : o.classes) {
+            bytes += c.in_use * c.object_size;
+        }
+    }
+    return bytes;
+}
+
+// 进程的常驻内存，不可用时返回 0
+std::size_t resident_bytes() {
+#ifdef __linux__
+    std::ifstream statm{"/proc/self/statm"};
+    std::size_t size = 0, resident = 0;
+    if (statm >> size >> resident) {
+        return resident * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+// tasks 个任务阻塞在同一个 channel 上，统计每个挂起任务占用的内存
+future<void> bench_idle_tasks() {
+    auto [tx, rx] = asco::sync::channel<void>();
+    std::atomic_size_t parked{0};
+
+    auto pool_before = pool_bytes_in_use();
+    auto rss_before = resident_bytes();
+
+    auto group = asco::spawn_many(
+        std::views::iota(std::size_t{0}, tasks) | std::views::transform([&](std::size_t) {
+            return [rx, &parked]() mutable -> future<bool> {
+                parked.fetch_add(1, std::memory_order::relaxed);
+                co_return co_await rx.recv();
+            };
+        }));
+
+    // 计数在 recv 之前递增，多让出几次使最后一批任务也进入挂起
+    while (parked.load(std::memory_order::relaxed) < tasks) {
+        co_await asco::this_task::yield();
+    }
+    for (std::size_t i = 0; i < 16; ++i) {
+        co_await asco::this_task::yield();
+    }
+
+    auto pool_bytes = pool_bytes_in_use() - pool_before;
+    auto rss_bytes = resident_bytes() - rss_before;
+    std::println(
+        "idle_tasks: tasks = {}, pool bytes/task = {}, rss bytes/task = {}", tasks, pool_bytes / tasks,
+        rss_bytes / tasks);
+
+    for (std::size_t i = 0; i < tasks; ++i) {
+        co_await tx.send();
+    }
+    std::size_t received = 0;
+    for (auto v : co_await group.join_all()) {
+        received += v;
+    }
+    if (received != tasks) {
+        asco::panic("bench_idle_tasks: 结果错误：{}", received);
+    }
+}
+
+}  // namespace
+
+int main() {
+    using namespace asco;
+
+    core::runtime rt = core::runtime_builder::multi_threaded().build();
+
+    try {
+        rt.block_on([&]() -> future<void> { co_await bench_idle_tasks(); });
+        return 0;
+    } catch (...) {
+        std::println("unknown exception");
+        return 1;
+    }
+}
@@ -0,0 +1,120 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <print>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+#include <asco/concurrency/concurrency.h>
+#include <asco/core/runtime.h>
+#include <asco/future.h>
+#include <asco/join_group.h>
+#include <asco/panic.h>
+#include <asco/sync/mutex.h>
+#include <asco/sync/semaphore.h>
+
+namespace {
+
+using asco::future;
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t ops_per_task = 2'000;
+
+// 临界区内做少量工作，使持有时间不为零
+void critical_section(std::size_t &counter) noexcept {
+    for (std::size_t i = 0; i < 16; ++i) {
+        asco::concurrency::cpu_relax();
+    }
+    ++counter;
+}
+
+// 原先的 mutex<> 即 binary_semaphore 的包装
+struct semaphore_lock {
+    asco::sync::binary_semaphore sem{1};
+
+    future<void> run(std::size_t &counter, std::vector<clock_type::duration> &latencies) {
+        for (std::size_t i = 0; i < ops_per_task; ++i) {
+            auto head = clock_type::now();
+            co_await sem.acquire();
+            latencies.push_back(clock_type::now() - head);
+            critical_section(counter);
+            sem.release();
+        }
+    }
+};
+
+struct fair_lock {
+    asco::sync::mutex<> m;
+
+    future<void> run(std::size_t &counter, std::vector<clock_type::duration> &latencies) {
+        for (std::size_t i = 0; i < ops_per_task; ++i) {
+            auto head = clock_type::now();
+            auto g = co_await m.lock();
+            latencies.push_back(clock_type::now() - head);
+            critical_section(counter);
+        }
+    }
+};
+
+// tasks 个任务争用同一把锁，输出吞吐量与加锁延迟的分位数
+template<typename Lock>
+future<void> bench_contention(std::string_view name, std::size_t tasks) {
+    Lock lock;
+    std::size_t counter = 0;
+    std::vector<std::vector<clock_type::duration>> latencies(tasks);
+    for (auto &v : latencies) {
+        v.reserve(ops_per_task);
+    }
+
+    auto start = clock_type::now();
+    auto group = asco::spawn_many(
+        std::views::iota(std::size_t{0}, tasks) | std::views::transform([&](std::size_t i) {
+            return [&, i]() -> future<void> { co_await lock.run(counter, latencies[i]); };
+        }));
+    co_await group.join_all();
+    auto elapsed = clock_type::now() - start;
+
+    if (counter != tasks * ops_per_task) {
+        asco::panic("bench_mutex: 结果错误：{}", counter);
+    }
+
+    std::vector<clock_type::duration> all;
+    all.reserve(tasks * ops_per_task);
+    for (auto &v : latencies) {
+        all.insert(all.end(), v.begin(), v.end());
+    }
+    std::ranges::sort(all);
+    auto ns = [](clock_type::duration d) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    };
+    auto secs = std::chrono::duration<double>(elapsed).count();
+    std::println(
+        "{}/{}: throughput = {:.0f} ops/s, p50 = {}ns, p99 = {}ns, max = {}ns", name, tasks,
+        static_cast<double>(counter) / secs, ns(all[all.size() / 2]), ns(all[all.size() * 99 / 100]),
+        ns(all.back()));
+}
+
+}  // namespace
+
+int main() {
+    using namespace asco;
+
+    core::runtime rt = core::runtime_builder::multi_threaded().build();
+
+    try {
+        rt.block_on([&]() -> future<void> {
+            for (std::size_t tasks : {2, 4, 8, 16, 32, 64}) {
+                co_await bench_contention<semaphore_lock>("mutex_semaphore", tasks);
+                co_await bench_contention<fair_lock>("mutex_fair", tasks);
+            }
+        });
+        return 0;
+    } catch (...) {
+        std::println("unknown exception");
+        return 1;
+    }
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <cstddef>
+#include <print>
+#include <string_view>
+#include <utility>
+
+#include <asco/core/runtime.h>
+#include <asco/future.h>
+#include <asco/panic.h>
+#include <asco/test/bench.h>
+
+namespace {
+
+using asco::future;
+
+future<std::size_t> nested(std::size_t depth) {
+    if (depth == 0) {
+        co_return 0;
+    }
+    co_return co_await nested(depth - 1) + 1;
+}
+
+future<void>
+bench_nested_await(std::string_view name, std::size_t depth, std::size_t warmup, std::size_t measure) {
+    asco::test::bench_context bench{name, warmup, measure};
+
+    for (std::size_t i = 0; i < warmup + measure; ++i) {
+        auto head = bench.get_span();
+        auto res = co_await nested(depth);
+        bench.commit(head);
+        if (res != depth) {
+            asco::panic("bench_nested_await: 嵌套深度 {} 的结果错误：{}", depth, res);
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    using namespace asco;
+
+    // 单线程 runtime，排除任务偷窃与跨线程唤醒的干扰，只测量 co_await 调用链本身的开销
+    core::runtime rt = core::runtime_builder::single_threaded().build();
+
+    constexpr std::size_t warmup = 1'000;
+    constexpr std::size_t measure = 100'000;
+
+    constexpr std::pair<std::string_view, std::size_t> cases[] = {
+        {"nested_await_depth_1", 1},
+        {"nested_await_depth_4", 4},
+        {"nested_await_depth_16", 16},
+        {"nested_await_depth_64", 64},
+        {"nested_await_depth_256", 256},
+    };
+
+    try {
+        rt.block_on([&]() -> future<void> {
+            for (auto [name, depth] : cases) {
+                co_await bench_nested_await(name, depth, warmup, measure);
+            }
+        });
+        return 0;
+    } catch (...) {
+        std::println("unknown exception");
+        return 1;
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <print>
+#include <ranges>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <asco/core/runtime.h>
+#include <asco/future.h>
+#include <asco/join_group.h>
+#include <asco/panic.h>
+#include <asco/sync/rwlock.h>
+#include <asco/sync/scalable_rwlock.h>
+
+namespace {
+
+using asco::future;
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t tasks_per_worker = 4;
+constexpr std::size_t ops_per_task = 20'000;
+// 每 write_period 次操作中有一次写，即 99% 为读
+constexpr std::size_t write_period = 100;
+
+// 每个 worker 上 tasks_per_worker 个任务反复读写同一把锁，输出总吞吐量
+template<typename Lock>
+future<void> bench_read_mostly(std::string_view name, std::size_t workers) {
+    Lock lock{std::size_t{0}};
+    std::size_t tasks = workers * tasks_per_worker;
+
+    auto start = clock_type::now();
+    auto group = asco::spawn_many(
+        std::views::iota(std::size_t{0}, tasks) | std::views::transform([&](std::size_t i) {
+            return [&, i]() -> future<void> {
+                std::size_t sum = 0;
+                for (std::size_t j = 0; j < ops_per_task; ++j) {
+                    if ((i + j) % write_period == 0) {
+                        auto g = co_await lock.write();
+                        ++*g;
+                    } else {
+                        auto g = co_await lock.read();
+                        sum += *g;
+                    }
+                }
+                (void)sum;
+            };
+        }));
+    co_await group.join_all();
+    auto elapsed = clock_type::now() - start;
+
+    auto g = co_await lock.read();
+    if (*g != tasks * ops_per_task / write_period) {
+        asco::panic("bench_rwlock: 结果错误：{}", *g);
+    }
+
+    auto secs = std::chrono::duration<double>(elapsed).count();
+    std::println(
+        "{}/{}: throughput = {:.0f} ops/s", name, workers,
+        static_cast<double>(tasks * ops_per_task) / secs);
+}
+
+}  // namespace
+
+int main() {
+    using namespace asco;
+
+    std::size_t max_workers = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::vector<std::size_t> worker_counts;
+    for (std::size_t n = 1; n < max_workers; n *= 2) {
+        worker_counts.push_back(n);
+    }
+    worker_counts.push_back(max_workers);
+
+    try {
+        for (auto workers : worker_counts) {
+            core::runtime rt = core::runtime_builder::multi_threaded(workers).build();
+            rt.block_on([&]() -> future<void> {
+                co_await bench_read_mostly<sync::rwlock<std::size_t>>("rwlock", workers);
+                co_await bench_read_mostly<sync::scalable_rwlock<std::size_t>>("scalable_rwlock", workers);
+            });
+        }
+        return 0;
+    } catch (...) {
+        std::println("unknown exception");
+        return 1;
+    }
+}
@@ -0,0 +1,97 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <string_view>
+
+#include <asco/core/cancellation.h>
+#include <asco/core/task/dynprio_scheduler.h>
+#include <asco/core/task/execution_domain.h>
+#include <asco/core/task/mlfq_scheduler.h>
+#include <asco/test/bench.h>
+
+namespace {
+
+using namespace asco::core;
+
+// 每个样本执行的调度次数
+constexpr std::size_t batch = 1024;
+
+struct bench_names {
+    std::string_view yield;
+    std::string_view wake;
+};
+
+// 调度器只把 execution_id 当作键使用，不会恢复协程，因此用互不相同的假地址代替真实协程
+task::execution_id fake_execution(std::size_t i) {
+    return task::execution_id::from_address(reinterpret_cast<void *>((i + 1) * 64));
+}
+
+template<typename Scheduler>
+void bench_scheduler(std::size_t executions, bench_names names, std::size_t warmup, std::size_t measure) {
+    Scheduler sched;
+    task::execution_domain domain{sched};
+    sched.bind_execution_domain(domain);
+
+    cancel_source cancel_src;
+    for (std::size_t i = 0; i < executions; ++i) {
+        sched.attach_execution(domain.attach_execution(fake_execution(i), {}, &cancel_src));
+    }
+
+    // 让出：取出一个 execution，运行后直接放回活动队列
+    {
+        asco::test::bench_context bench{names.yield, warmup, measure};
+        for (std::size_t round = 0; round < warmup + measure; ++round) {
+            auto head = bench.get_span();
+            for (std::size_t i = 0; i < batch; ++i) {
+                auto [exec, ctx] = sched.schedule();
+                domain.schedule_execution(exec);
+                ctx.begin();
+                ctx.end(false);
+            }
+            bench.commit(head);
+        }
+    }
+
+    // 挂起后立即唤醒：覆盖挂起集合与唤醒路径
+    {
+        asco::test::bench_context bench{names.wake, warmup, measure};
+        for (std::size_t round = 0; round < warmup + measure; ++round) {
+            auto head = bench.get_span();
+            for (std::size_t i = 0; i < batch; ++i) {
+                auto [exec, ctx] = sched.schedule();
+                domain.schedule_execution(exec);
+                ctx.begin();
+                sched.suspend_current(exec);
+                ctx.end(false);
+                domain.awake_execution(exec.id);
+            }
+            bench.commit(head);
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    constexpr std::size_t warmup = 50;
+    constexpr std::size_t measure = 1000;
+
+    std::println("每个样本包含 {} 次调度", batch);
+
+    bench_scheduler<task::dynprio_scheduler>(1'000, {"dynprio_yield_1k", "dynprio_wake_1k"}, warmup, measure);
+    bench_scheduler<task::mlfq_scheduler>(1'000, {"mlfq_yield_1k", "mlfq_wake_1k"}, warmup, measure);
+
+    bench_scheduler<task::dynprio_scheduler>(
+        100'000, {"dynprio_yield_100k", "dynprio_wake_100k"}, warmup, measure);
+    bench_scheduler<task::mlfq_scheduler>(100'000, {"mlfq_yield_100k", "mlfq_wake_100k"}, warmup, measure);
+
+    bench_scheduler<task::dynprio_scheduler>(
+        1'000'000, {"dynprio_yield_1m", "dynprio_wake_1m"}, warmup, measure);
+    bench_scheduler<task::mlfq_scheduler>(1'000'000, {"mlfq_yield_1m", "mlfq_wake_1m"}, warmup, measure);
+
+    return 0;
+}
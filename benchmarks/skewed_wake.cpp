@@ -0,0 +1,141 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <print>
+#include <vector>
+
+#include <asco/core/runtime.h>
+#include <asco/core/worker.h>
+#include <asco/future.h>
+#include <asco/join_handle.h>
+#include <asco/sync/condition_variable.h>
+#include <asco/test/bench.h>
+#include <asco/yield.h>
+
+namespace {
+
+using asco::future;
+
+constexpr std::size_t waiters = 256;
+constexpr auto work = std::chrono::microseconds{20};
+constexpr std::size_t stop_round = std::numeric_limits<std::size_t>::max();
+
+struct waiter_slot {
+    asco::sync::condition_variable cv;
+    std::atomic_size_t round{0};
+    std::size_t home{0};
+};
+
+struct shared_state {
+    std::vector<std::unique_ptr<waiter_slot>> slots;
+    std::atomic_size_t started{0};
+    std::atomic_size_t done{0};
+};
+
+void busy_for(std::chrono::nanoseconds d) {
+    const auto deadline = std::chrono::steady_clock::now() + d;
+    while (std::chrono::steady_clock::now() < deadline)
+        ;
+}
+
+future<void> waiter(shared_state &st, waiter_slot &slot) {
+    slot.home = asco::core::worker::current().id();
+    st.started.fetch_add(1, std::memory_order::acq_rel);
+
+    std::size_t seen = 0;
+    while (true) {
+        co_await slot.cv.wait([&] { return slot.round.load(std::memory_order::acquire) != seen; });
+        seen = slot.round.load(std::memory_order::acquire);
+        if (seen == stop_round) {
+            co_return;
+        }
+        busy_for(work);
+        st.done.fetch_add(1, std::memory_order::acq_rel);
+    }
+}
+
+// 每轮只唤醒初始时驻留在同一个 worker 上的那一组任务，测量整组任务全部完成的时间
+future<void> bench_skewed_wake(std::size_t warmup, std::size_t measure) {
+    shared_state st;
+    for (std::size_t i = 0; i < waiters; ++i) {
+        st.slots.push_back(std::make_unique<waiter_slot>());
+    }
+
+    std::vector<asco::join_handle<void>> hs;
+    hs.reserve(waiters);
+    for (auto &slot : st.slots) {
+        hs.push_back(asco::spawn([&st, s = slot.get()]() -> future<void> { return waiter(st, *s); }));
+    }
+    while (st.started.load(std::memory_order::acquire) < waiters) {
+        co_await asco::this_task::yield();
+    }
+
+    std::vector<std::size_t> population;
+    for (auto &slot : st.slots) {
+        if (slot->home >= population.size()) {
+            population.resize(slot->home + 1);
+        }
+        ++population[slot->home];
+    }
+    const auto hot_worker =
+        static_cast<std::size_t>(std::ranges::max_element(population) - population.begin());
+    std::vector<waiter_slot *> hot;
+    for (auto &slot : st.slots) {
+        if (slot->home == hot_worker) {
+            hot.push_back(slot.get());
+        }
+    }
+    std::println("skewed_wake: {} of {} waiters start on worker {}", hot.size(), waiters, hot_worker);
+
+    {
+        asco::test::bench_context bench{"skewed_wake", warmup, measure};
+
+        for (std::size_t round = 1; round <= warmup + measure; ++round) {
+            auto head = bench.get_span();
+            for (auto slot : hot) {
+                slot->round.store(round, std::memory_order::release);
+                slot->cv.notify_one();
+            }
+            while (st.done.load(std::memory_order::acquire) < round * hot.size()) {
+                co_await asco::this_task::yield();
+            }
+            bench.commit(head);
+        }
+    }
+
+    for (auto &slot : st.slots) {
+        slot->round.store(stop_round, std::memory_order::release);
+        slot->cv.notify_one();
+    }
+    for (auto &h : hs) {
+        co_await h;
+    }
+}
+
+}  // namespace
+
+int main() {
+    using namespace asco;
+
+    core::runtime rt = core::runtime_builder::multi_threaded().build();
+
+    constexpr std::size_t warmup = 20;
+    constexpr std::size_t measure = 500;
+
+    try {
+        rt.block_on([&]() -> future<void> { co_await bench_skewed_wake(warmup, measure); });
+        auto stats = rt.get_park_stats();
+        std::println(
+            "parks = {}, unparks = {}, migrations = {}", stats.parks, stats.unparks, stats.migrations);
+        return 0;
+    } catch (...) {
+        std::println("unknown exception");
+        return 1;
+    }
+}
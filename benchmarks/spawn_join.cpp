@@ -0,0 +1,98 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <print>
+
+#include <asco/core/runtime.h>
+#include <asco/future.h>
+#include <asco/join_handle.h>
+#include <asco/panic.h>
+#include <asco/test/bench.h>
+
+namespace {
+
+// 统计所有线程上的堆分配次数，coroutine_pool 命中 freelist 时不经过这里
+std::atomic_size_t heap_allocations{0};
+
+void *counted_alloc(std::size_t size, std::size_t align) {
+    heap_allocations.fetch_add(1, std::memory_order::relaxed);
+    if (!size) {
+        size = 1;
+    }
+    void *p = align > alignof(std::max_align_t)
+                  ? std::aligned_alloc(align, (size + align - 1) / align * align)
+                  : std::malloc(size);
+    if (!p) {
+        throw std::bad_alloc{};
+    }
+    return p;
+}
+
+}  // namespace
+
+void *operator new(std::size_t size) { return counted_alloc(size, alignof(std::max_align_t)); }
+void *operator new[](std::size_t size) { return counted_alloc(size, alignof(std::max_align_t)); }
+void *operator new(std::size_t size, std::align_val_t align) {
+    return counted_alloc(size, static_cast<std::size_t>(align));
+}
+void *operator new[](std::size_t size, std::align_val_t align) {
+    return counted_alloc(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+using asco::future;
+
+future<void> bench_spawn_join(std::size_t warmup, std::size_t measure) {
+    std::size_t allocations = 0;
+    {
+        asco::test::bench_context bench{"spawn_join", warmup, measure};
+
+        for (std::size_t i = 0; i < warmup + measure; ++i) {
+            auto before = heap_allocations.load(std::memory_order::relaxed);
+            auto head = bench.get_span();
+            auto v = co_await asco::spawn([i]() -> future<std::size_t> { co_return i; });
+            bench.commit(head);
+            if (i >= warmup) {
+                allocations += heap_allocations.load(std::memory_order::relaxed) - before;
+            }
+            if (v != i) {
+                asco::panic("bench_spawn_join: 结果错误：{}", v);
+            }
+        }
+    }
+    std::println("spawn_join: {:.2f} heap allocations per spawn/join", double(allocations) / double(measure));
+}
+
+}  // namespace
+
+int main() {
+    using namespace asco;
+
+    // 单线程 runtime：spawn 出的任务总在同一个 worker 上运行，分配次数不受偷窃与迁移影响
+    core::runtime rt = core::runtime_builder::single_threaded().build();
+
+    constexpr std::size_t warmup = 1'000;
+    constexpr std::size_t measure = 100'000;
+
+    try {
+        rt.block_on([&]() -> future<void> { co_await bench_spawn_join(warmup, measure); });
+        return 0;
+    } catch (...) {
+        std::println("unknown exception");
+        return 1;
+    }
+}
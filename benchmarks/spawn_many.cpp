@@ -0,0 +1,82 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <cstddef>
+#include <print>
+#include <ranges>
+#include <vector>
+
+#include <asco/core/runtime.h>
+#include <asco/future.h>
+#include <asco/join_group.h>
+#include <asco/join_handle.h>
+#include <asco/panic.h>
+#include <asco/test/bench.h>
+
+namespace {
+
+using asco::future;
+
+constexpr std::size_t fanout = 10'000;
+
+future<void> bench_spawn_loop(std::size_t warmup, std::size_t measure) {
+    asco::test::bench_context bench{"spawn_loop_10k", warmup, measure};
+
+    for (std::size_t round = 0; round < warmup + measure; ++round) {
+        auto head = bench.get_span();
+        std::vector<asco::join_handle<std::size_t>> hs;
+        hs.reserve(fanout);
+        for (std::size_t i = 0; i < fanout; ++i) {
+            hs.push_back(asco::spawn([i]() -> future<std::size_t> { co_return i; }));
+        }
+        std::size_t sum = 0;
+        for (auto &h : hs) {
+            sum += co_await h;
+        }
+        bench.commit(head);
+        if (sum != fanout * (fanout - 1) / 2) {
+            asco::panic("bench_spawn_loop: 结果错误：{}", sum);
+        }
+    }
+}
+
+future<void> bench_spawn_many(std::size_t warmup, std::size_t measure) {
+    asco::test::bench_context bench{"spawn_many_10k", warmup, measure};
+
+    for (std::size_t round = 0; round < warmup + measure; ++round) {
+        auto head = bench.get_span();
+        auto group = asco::spawn_many(
+            std::views::iota(std::size_t{0}, fanout)
+            | std::views::transform([](std::size_t i) { return [i]() -> future<std::size_t> { co_return i; }; }));
+        std::size_t sum = 0;
+        for (auto v : co_await group.join_all()) {
+            sum += v;
+        }
+        bench.commit(head);
+        if (sum != fanout * (fanout - 1) / 2) {
+            asco::panic("bench_spawn_many: 结果错误：{}", sum);
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    using namespace asco;
+
+    core::runtime rt = core::runtime_builder::multi_threaded().build();
+
+    constexpr std::size_t warmup = 10;
+    constexpr std::size_t measure = 200;
+
+    try {
+        rt.block_on([&]() -> future<void> {
+            co_await bench_spawn_loop(warmup, measure);
+            co_await bench_spawn_many(warmup, measure);
+        });
+        return 0;
+    } catch (...) {
+        std::println("unknown exception");
+        return 1;
+    }
+}
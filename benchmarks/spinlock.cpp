@@ -0,0 +1,107 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <print>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <asco/concurrency/concurrency.h>
+#include <asco/sync/mcs_spinlock.h>
+#include <asco/sync/spinlock.h>
+#include <asco/sync/ticket_spinlock.h>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr auto duration = std::chrono::milliseconds{300};
+
+// 受保护的数据，记录上一个持有者，用于统计所有权在线程间的转移
+struct shared_state {
+    std::size_t owner{0};
+    std::size_t handoffs{0};
+    std::size_t counter{0};
+};
+
+// threads 个线程在 duration 内反复争用同一把锁
+// 输出吞吐量、所有权跨线程转移的比例（每次转移意味着受保护数据的缓存行被迁移），
+// 以及各线程加锁次数的最小/最大比值和 Jain 公平性指数
+template<typename Lock>
+void bench_contention(std::string_view name, std::size_t threads) {
+    Lock lock{shared_state{}};
+    std::atomic_bool start{false};
+    std::atomic_bool stop{false};
+    std::vector<std::size_t> counts(threads);
+
+    std::vector<std::thread> ts;
+    for (std::size_t i = 0; i < threads; ++i) {
+        ts.emplace_back([&, i] {
+            while (!start.load(std::memory_order::acquire)) {
+                asco::concurrency::cpu_relax();
+            }
+            std::size_t n = 0;
+            while (!stop.load(std::memory_order::relaxed)) {
+                {
+                    auto g = lock.lock();
+                    g->handoffs += g->owner != i + 1;
+                    g->owner = i + 1;
+                    ++g->counter;
+                }
+                ++n;
+                // 临界区外做少量工作，避免同一线程连续重入
+                for (std::size_t k = 0; k < 32; ++k) {
+                    asco::concurrency::cpu_relax();
+                }
+            }
+            counts[i] = n;
+        });
+    }
+
+    start.store(true, std::memory_order::release);
+    std::this_thread::sleep_for(duration);
+    stop.store(true, std::memory_order::relaxed);
+    for (auto &t : ts) {
+        t.join();
+    }
+
+    auto g = lock.lock();
+    auto [min, max] = std::ranges::minmax(counts);
+    double sum = 0;
+    double sum_sq = 0;
+    for (auto c : counts) {
+        sum += static_cast<double>(c);
+        sum_sq += static_cast<double>(c) * static_cast<double>(c);
+    }
+    auto secs = std::chrono::duration<double>(duration).count();
+    std::println(
+        "{}/{}: throughput = {:.0f} ops/s, handoffs = {:.3f}/op, min/max = {:.3f}, jain = {:.3f}", name,
+        threads, static_cast<double>(g->counter) / secs,
+        static_cast<double>(g->handoffs) / static_cast<double>(g->counter),
+        max ? static_cast<double>(min) / static_cast<double>(max) : 0.0,
+        sum_sq ? sum * sum / (static_cast<double>(threads) * sum_sq) : 0.0);
+}
+
+}  // namespace
+
+int main() {
+    using namespace asco;
+
+    std::size_t max_threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t n = 1; n < max_threads; n *= 2) {
+        thread_counts.push_back(n);
+    }
+    thread_counts.push_back(max_threads);
+
+    for (auto threads : thread_counts) {
+        bench_contention<sync::spinlock<shared_state>>("spinlock", threads);
+        bench_contention<sync::ticket_spinlock<shared_state>>("ticket_spinlock", threads);
+        bench_contention<sync::mcs_spinlock<shared_state>>("mcs_spinlock", threads);
+    }
+    return 0;
+}
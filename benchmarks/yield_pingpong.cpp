@@ -0,0 +1,63 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <atomic>
+#include <cstddef>
+#include <print>
+
+#include <asco/core/runtime.h>
+#include <asco/future.h>
+#include <asco/join_handle.h>
+#include <asco/test/bench.h>
+#include <asco/yield.h>
+
+namespace {
+
+using asco::future;
+
+// 每个样本中本任务让出的次数，每次让出都会切换到对端任务再切换回来
+constexpr std::size_t rounds_per_sample = 1'000;
+
+future<void> bench_yield_pingpong(std::size_t warmup, std::size_t measure) {
+    std::atomic_bool stop{false};
+    auto partner = asco::spawn([&]() -> future<void> {
+        while (!stop.load(std::memory_order::acquire)) {
+            co_await asco::this_task::yield();
+        }
+    });
+
+    {
+        asco::test::bench_context bench{"yield_pingpong_1k", warmup, measure};
+
+        for (std::size_t i = 0; i < warmup + measure; ++i) {
+            auto head = bench.get_span();
+            for (std::size_t j = 0; j < rounds_per_sample; ++j) {
+                co_await asco::this_task::yield();
+            }
+            bench.commit(head);
+        }
+    }
+
+    stop.store(true, std::memory_order::release);
+    co_await partner;
+}
+
+}  // namespace
+
+int main() {
+    using namespace asco;
+
+    // 单线程 runtime：两个任务在同一个 worker 上轮流让出，测量每次恢复的调度开销
+    core::runtime rt = core::runtime_builder::single_threaded().build();
+
+    constexpr std::size_t warmup = 100;
+    constexpr std::size_t measure = 10'000;
+
+    try {
+        rt.block_on([&]() -> future<void> { co_await bench_yield_pingpong(warmup, measure); });
+        return 0;
+    } catch (...) {
+        std::println("unknown exception");
+        return 1;
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#    include <malloc.h>
+#endif
+
+#include <asco/core/runtime.h>
+#include <asco/join_handle.h>
+#include <asco/test/test.h>
+#include <asco/yield.h>
+
+using namespace asco;
+
+namespace {
+
+// 只统计打开计数的线程上发生的分配
+thread_local bool counting{false};
+thread_local std::size_t allocations{0};
+
+void *counted_alloc(std::size_t size) {
+    if (counting) {
+        ++allocations;
+    }
+    if (!size) {
+        size = 1;
+    }
+    if (auto p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+// MSVC 没有 std::aligned_alloc ，且其对齐分配必须由 _aligned_free 释放
+void *counted_aligned_alloc(std::size_t size, std::align_val_t align) {
+    if (counting) {
+        ++allocations;
+    }
+    auto a = static_cast<std::size_t>(align);
+    if (!size) {
+        size = 1;
+    }
+#ifdef _WIN32
+    auto p = _aligned_malloc(size, a);
+#else
+    auto p = std::aligned_alloc(a, (size + a - 1) / a * a);
+#endif
+    if (!p) {
+        throw std::bad_alloc{};
+    }
+    return p;
+}
+
+void aligned_free(void *p) noexcept {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+};  // namespace
+
+void *operator new(std::size_t size) { return counted_alloc(size); }
+void *operator new[](std::size_t size) { return counted_alloc(size); }
+void *operator new(std::size_t size, std::align_val_t align) { return counted_aligned_alloc(size, align); }
+void *operator new[](std::size_t size, std::align_val_t align) { return counted_aligned_alloc(size, align); }
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { aligned_free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { aligned_free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { aligned_free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { aligned_free(p); }
+
+ASCO_TEST(yield_resume_path_does_not_allocate) {
+    // 独立的单线程 runtime：计数期间它的 worker 线程上只运行这一个任务
+    core::runtime rt = core::runtime_builder::single_threaded().build();
+
+    constexpr std::size_t warmup = 1024;
+    constexpr std::size_t rounds = 1'000'000;
+
+    auto h = rt.spawn([]() -> future<std::size_t> {
+        for (std::size_t i = 0; i < warmup; ++i) {
+            co_await this_task::yield();
+        }
+
+        allocations = 0;
+        counting = true;
+        for (std::size_t i = 0; i < rounds; ++i) {
+            co_await this_task::yield();
+        }
+        counting = false;
+        co_return allocations;
+    });
+    auto n = co_await h;
+
+    ASCO_CHECK(n == 0, "yield/resume should not allocate once warmed up, got {} allocations", n);
+
+    ASCO_SUCCESS();
+}
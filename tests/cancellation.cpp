@@ -62,9 +62,7 @@ struct cancellable_never_ready {
             if (callback_called)
                 callback_called->release();
         });
-        auto &w = core::worker::current();
-        auto id = w.get_executor().current_execution();
-        w.get_current_scheduler().suspend_current(id);
+        core::worker::current().suspend_current();
 
         if (started)
             started->release();
@@ -0,0 +1,143 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <cstddef>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+#include <asco/core/mm/coroutine_pool.h>
+#include <asco/test/test.h>
+
+using namespace asco;
+
+ASCO_TEST(coroutine_pool_returns_cross_thread_frees_to_owner) {
+    using core::mm::coroutine_pool;
+
+    constexpr std::size_t n = 256;
+    constexpr std::size_t size = 200;
+
+    std::vector<void *> ptrs;
+    std::binary_semaphore allocated{0};
+    std::binary_semaphore freed{0};
+
+    coroutine_pool::occupancy pending{};
+    coroutine_pool::occupancy drained{};
+    bool reused = false;
+
+    std::thread owner{[&] {
+        for (std::size_t i = 0; i < n; ++i) {
+            ptrs.push_back(coroutine_pool::allocate(size));
+        }
+        allocated.release();
+        freed.acquire();
+
+        pending = coroutine_pool::local_occupancy();
+        // 本线程 freelist 为空，分配时成批取回其它线程归还的对象
+        auto p = coroutine_pool::allocate(size);
+        drained = coroutine_pool::local_occupancy();
+        reused = std::ranges::find(ptrs, p) != ptrs.end();
+        coroutine_pool::deallocate(p, size);
+    }};
+
+    allocated.acquire();
+    // 在另一个线程上释放
+    for (auto p : ptrs) {
+        coroutine_pool::deallocate(p, size);
+    }
+    freed.release();
+    owner.join();
+
+    ASCO_CHECK(
+        pending.pending_remote_frees == n, "remote frees should queue on the owner, got {}",
+        pending.pending_remote_frees);
+    ASCO_CHECK(
+        pending.remote_frees == n, "owner should count {} remote frees, got {}", n, pending.remote_frees);
+    ASCO_CHECK(drained.pending_remote_frees == 0, "allocation should drain the remote queue");
+    ASCO_CHECK(drained.cached_objects == n - 1, "drained objects should land in the owner's freelist");
+    ASCO_CHECK(reused, "owner should reuse memory freed by another thread");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(coroutine_pool_trim_returns_idle_memory) {
+    using core::mm::coroutine_pool;
+
+    constexpr std::size_t n = 4096;
+    constexpr std::size_t size = 200;
+    constexpr std::size_t index = ((size + 8 + 7) / 8 * 8 - 1) / 64;  // 对象所属的大小级别
+
+    coroutine_pool::occupancy burst{};
+    coroutine_pool::occupancy idle{};
+    std::size_t released = 0;
+
+    // 在新线程上模拟一次突发流量，避免与其它测试共享线程局部的池
+    std::thread t{[&] {
+        std::vector<void *> ptrs;
+        for (std::size_t i = 0; i < n; ++i) {
+            ptrs.push_back(coroutine_pool::allocate(size));
+        }
+        for (auto p : ptrs) {
+            coroutine_pool::deallocate(p, size);
+        }
+        burst = coroutine_pool::local_occupancy();
+        released = coroutine_pool::trim();
+        idle = coroutine_pool::local_occupancy();
+    }};
+    t.join();
+
+    ASCO_CHECK(burst.classes[index].cached > 0, "freed objects should be cached after the burst");
+    ASCO_CHECK(
+        burst.classes[index].in_use == 0, "no object should remain in use, got {}", burst.classes[index].in_use);
+    ASCO_CHECK(idle.cached_bytes == 0, "trim(0) should empty the freelists, got {} bytes", idle.cached_bytes);
+    ASCO_CHECK(idle.blocks == 0, "every block should be released, {} left", idle.blocks);
+    ASCO_CHECK(
+        released == burst.block_bytes, "trim should report {} released bytes, got {}", burst.block_bytes,
+        released);
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(coroutine_pool_exiting_thread_releases_its_blocks) {
+    using core::mm::coroutine_pool;
+
+    constexpr std::size_t n = 256;
+    constexpr std::size_t size = 200;
+
+    auto before = coroutine_pool::orphaned_blocks();
+
+    // 线程退出时一半对象已归还到它的 freelist ，另一半仍在其它线程手中
+    std::vector<void *> live;
+    std::size_t blocks = 0;
+    std::thread t{[&] {
+        std::vector<void *> ptrs;
+        for (std::size_t i = 0; i < n; ++i) {
+            ptrs.push_back(coroutine_pool::allocate(size));
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i % 2) {
+                coroutine_pool::deallocate(ptrs[i], size);
+            } else {
+                live.push_back(ptrs[i]);
+            }
+        }
+        blocks = coroutine_pool::local_occupancy().blocks;
+    }};
+    t.join();
+
+    auto orphaned = coroutine_pool::orphaned_blocks() - before;
+    ASCO_CHECK(
+        orphaned > 0 && orphaned <= blocks, "blocks with live objects should stay until freed, got {} of {}",
+        orphaned, blocks);
+
+    for (auto p : live) {
+        coroutine_pool::deallocate(p, size);
+    }
+    ASCO_CHECK(
+        coroutine_pool::orphaned_blocks() == before,
+        "freeing the last object of an exited thread's block should release it, {} left",
+        coroutine_pool::orphaned_blocks() - before);
+
+    ASCO_SUCCESS();
+}
@@ -0,0 +1,44 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include <asco/core/mm/frame_profiler.h>
+#include <asco/future.h>
+#include <asco/test/test.h>
+#include <asco/util/compile_config.h>
+#include <asco/yield.h>
+
+using namespace asco;
+
+namespace {
+
+// 跨越挂起点的大数组使协程帧超出 coroutine_pool 的 freelist 上限
+future<std::size_t> bloated_frame() {
+    std::array<std::byte, 8192> scratch{};
+    scratch[0] = std::byte{1};
+    co_await this_task::yield();
+    co_return std::ranges::count(scratch, std::byte{1});
+}
+
+}  // namespace
+
+ASCO_TEST(frame_profiler_reports_frames_bypassing_the_pool) {
+    if constexpr (!util::compile_config::perf_record) {
+        ASCO_SUCCESS();
+    }
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        ASCO_CHECK(co_await bloated_frame() == 1, "bloated coroutine should complete normally");
+    }
+
+    auto sites = core::mm::frame_profiler::report();
+    auto it = std::ranges::find_if(sites, [](const auto &s) { return !s.pooled && s.frame_size > 8192; });
+    ASCO_CHECK(it != sites.end(), "a coroutine frame larger than the pool limit should be reported");
+    ASCO_CHECK(it->allocations >= 4, "every allocation should be counted, got {}", it->allocations);
+    ASCO_CHECK(it->live == 0, "completed frames should not stay live, got {}", it->live);
+
+    ASCO_SUCCESS();
+}
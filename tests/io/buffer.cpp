@@ -1,15 +1,19 @@
 // Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
 // SPDX-License-Identifier: MIT
 
+#include <asco/core/mm/buffer_pool.h>
 #include <asco/io/buffer.h>
 #include <asco/test/test.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 #include <memory_resource>
 #include <span>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 namespace {
 
@@ -293,4 +297,47 @@ ASCO_TEST(buffer_self_move_assignment_keeps_buffer_usable) {
     ASCO_CHECK(view(buf) == "self", "self move should keep content");
 
     ASCO_SUCCESS();
-}
\ No newline at end of file
+}
+
+ASCO_TEST(buffer_default_pool_returns_cross_thread_frees_to_owner) {
+    using asco::core::mm::buffer_pool;
+
+    constexpr std::size_t n = 64;
+    constexpr std::size_t size = 4096;
+
+    buffer_pool::occupancy pending{};
+    buffer_pool::occupancy drained{};
+    bool reused = false;
+
+    // 在新线程上分配，避免与其它测试共享线程局部的池
+    std::thread owner{[&] {
+        std::vector<asco::io::buffer<>> bufs;
+        for (std::size_t i = 0; i < n; ++i) {
+            bufs.emplace_back(size);
+        }
+        std::vector<std::byte *> addrs;
+        for (auto &buf : bufs) {
+            addrs.push_back(buf.data());
+        }
+
+        std::thread{[&] { bufs.clear(); }}.join();
+
+        pending = buffer_pool::local_occupancy();
+        // 缓存为空，分配时取回其它线程归还的缓冲区
+        asco::io::buffer<> buf{size};
+        drained = buffer_pool::local_occupancy();
+        reused = std::ranges::find(addrs, buf.data()) != addrs.end();
+    }};
+    owner.join();
+
+    ASCO_CHECK(
+        pending.pending_remote_frees == n, "remote frees should queue on the owner, got {}",
+        pending.pending_remote_frees);
+    ASCO_CHECK(drained.pending_remote_frees == 0, "allocation should drain the remote queue");
+    ASCO_CHECK(
+        drained.cached_buffers == n - 1, "drained buffers should land in the owner's cache, got {}",
+        drained.cached_buffers);
+    ASCO_CHECK(reused, "owner should reuse a buffer freed by another thread");
+
+    ASCO_SUCCESS();
+}
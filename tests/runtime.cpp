@@ -0,0 +1,476 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "async_test_utils.h"
+
+#include <asco/core/runtime.h>
+#include <asco/core/worker.h>
+#include <asco/join_handle.h>
+#include <asco/sync/condition_variable.h>
+#include <asco/test/test.h>
+#include <asco/yield.h>
+
+using namespace asco;
+
+ASCO_TEST(runtime_nested_spawns_all_complete) {
+    constexpr std::size_t parents = 32;
+    constexpr std::size_t children = 32;
+
+    std::vector<join_handle<std::size_t>> hs;
+    hs.reserve(parents);
+    for (std::size_t i = 0; i < parents; ++i) {
+        hs.push_back(spawn([]() -> future<std::size_t> {
+            std::vector<join_handle<std::size_t>> chs;
+            chs.reserve(children);
+            for (std::size_t j = 0; j < children; ++j) {
+                chs.push_back(spawn([j]() -> future<std::size_t> {
+                    co_await this_task::yield();
+                    co_await this_task::yield();
+                    co_return j;
+                }));
+            }
+            std::size_t sum = 0;
+            for (auto &h : chs) {
+                sum += co_await h;
+            }
+            co_return sum;
+        }));
+    }
+
+    std::size_t total = 0;
+    for (auto &h : hs) {
+        total += co_await h;
+    }
+
+    constexpr std::size_t expected = parents * (children * (children - 1) / 2);
+    ASCO_CHECK(total == expected, "all nested spawns should complete, got sum {}, expected {}", total, expected);
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(runtime_local_task_stolen_by_idle_worker) {
+    if (std::thread::hardware_concurrency() < 2) {
+        ASCO_SUCCESS();
+    }
+
+    // 父任务忙等且不让出 worker，子任务只能在被其它 worker 偷取后运行
+    auto h = spawn([]() -> future<bool> {
+        std::atomic_bool ran{false};
+        auto child = spawn([&ran]() -> future<void> {
+            ran.store(true, std::memory_order::release);
+            co_return;
+        });
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (!ran.load(std::memory_order::acquire) && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        auto stolen = ran.load(std::memory_order::acquire);
+
+        co_await child;
+        co_return stolen;
+    });
+
+    ASCO_CHECK(co_await h, "a task spawned by a busy worker should be stolen by an idle worker");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(runtime_injection_does_not_block_beyond_ring_capacity) {
+    // 从另一个 runtime 的 worker 上 spawn，所有任务都经过全局注入队列
+    core::runtime rt = core::runtime_builder::single_threaded().build();
+
+    constexpr std::size_t n = 5000;
+    std::atomic_size_t done{0};
+
+    std::vector<join_handle<void>> hs;
+    hs.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        hs.push_back(rt.spawn([&done]() -> future<void> {
+            done.fetch_add(1, std::memory_order::acq_rel);
+            co_return;
+        }));
+    }
+    for (auto &h : hs) {
+        co_await h;
+    }
+
+    ASCO_CHECK(done.load() == n, "all injected tasks should complete, got {}", done.load());
+
+    ASCO_SUCCESS();
+}
+
+namespace {
+
+// 在当前 worker 上同时保持 n 个子任务存活
+future<std::size_t> spawn_children(std::size_t n) {
+    std::vector<join_handle<std::size_t>> hs;
+    hs.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        hs.push_back(spawn([i]() -> future<std::size_t> {
+            co_await this_task::yield();
+            co_return i;
+        }));
+    }
+    std::size_t sum = 0;
+    for (auto &h : hs) {
+        sum += co_await h;
+    }
+    co_return sum;
+}
+
+}  // namespace
+
+ASCO_TEST(runtime_task_capacity_reports_overflow) {
+    {
+        core::runtime rt = core::runtime_builder::single_threaded()  //
+                               .with_task_capacity(128)
+                               .build();
+        // 每轮至多 n + 1 个任务同时存活，总任务数远超预留容量，结束的任务必须归还记录与协程帧
+        constexpr std::size_t n = 64;
+        constexpr std::size_t rounds = 8;
+        auto h = rt.spawn([]() -> future<bool> {
+            for (std::size_t i = 0; i < rounds; ++i) {
+                if (co_await spawn_children(n) != n * (n - 1) / 2) {
+                    co_return false;
+                }
+            }
+            co_return true;
+        });
+        ASCO_CHECK(co_await h, "all tasks within the reserved capacity should complete");
+
+        auto stats = rt.get_task_capacity_stats();
+        ASCO_CHECK(stats.capacity == 128, "capacity should be reported, got {}", stats.capacity);
+        ASCO_CHECK(
+            stats.record_overflows == 0, "no record should be created beyond the reservation, got {}",
+            stats.record_overflows);
+        ASCO_CHECK(
+            stats.frame_overflows == 0, "no frame should be allocated beyond the reservation, got {}",
+            stats.frame_overflows);
+    }
+    {
+        core::runtime rt = core::runtime_builder::single_threaded()  //
+                               .with_task_capacity(8)
+                               .build();
+        constexpr std::size_t n = 32;
+        auto h = rt.spawn([]() { return spawn_children(n); });
+        ASCO_CHECK(co_await h == n * (n - 1) / 2, "tasks beyond the reserved capacity should still complete");
+
+        auto stats = rt.get_task_capacity_stats();
+        ASCO_CHECK(stats.record_overflows > 0, "exceeding the reserved capacity should be reported");
+    }
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(runtime_spawn_async_waits_when_saturated) {
+    core::runtime rt = core::runtime_builder::single_threaded()  //
+                           .with_max_pending_tasks(4)
+                           .build();
+
+    constexpr std::size_t n = 256;
+    std::atomic_size_t done{0};
+
+    std::vector<join_handle<void>> hs;
+    hs.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        hs.push_back(co_await rt.spawn_async([&done]() -> future<void> {
+            co_await this_task::yield();
+            done.fetch_add(1, std::memory_order::acq_rel);
+        }));
+    }
+    for (auto &h : hs) {
+        co_await h;
+    }
+
+    ASCO_CHECK(done.load() == n, "all tasks spawned by spawn_async should complete, got {}", done.load());
+    ASCO_CHECK(!rt.saturated(), "runtime should not stay saturated after all tasks completed");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(runtime_spawn_async_concurrent_producers_all_complete) {
+    core::runtime rt = core::runtime_builder::single_threaded()  //
+                           .with_max_pending_tasks(4)
+                           .build();
+
+    constexpr std::size_t producers = 8;
+    constexpr std::size_t per_producer = 64;
+    std::atomic_size_t done{0};
+
+    // 多个生产者同时在饱和的 runtime 上等待空位，被一起唤醒时各自占用空位
+    std::vector<join_handle<void>> ps;
+    for (std::size_t p = 0; p < producers; ++p) {
+        ps.push_back(spawn([&]() -> future<void> {
+            std::vector<join_handle<void>> hs;
+            for (std::size_t i = 0; i < per_producer; ++i) {
+                hs.push_back(co_await rt.spawn_async([&done]() -> future<void> {
+                    co_await this_task::yield();
+                    done.fetch_add(1, std::memory_order::acq_rel);
+                }));
+            }
+            for (auto &h : hs) {
+                co_await h;
+            }
+        }));
+    }
+    for (auto &p : ps) {
+        co_await p;
+    }
+
+    ASCO_CHECK(
+        done.load() == producers * per_producer,
+        "every task spawned by concurrent producers should complete");
+    ASCO_CHECK(!rt.saturated(), "reserved pending slots should all be released after the tasks completed");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(runtime_park_stats_track_idle_workers) {
+    core::runtime rt = core::runtime_builder::multi_threaded(2).build();
+
+    // 没有任务时 worker 自旋结束后进入休眠
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    auto before = rt.get_park_stats();
+    ASCO_CHECK(before.parks >= 1, "idle workers should park, got {} parks", before.parks);
+
+    for (std::size_t i = 0; i < 64; ++i) {
+        co_await rt.spawn([]() -> future<void> { co_return; });
+    }
+
+    auto after = rt.get_park_stats();
+    ASCO_CHECK(
+        after.unparks + after.skipped_wakes > before.unparks + before.skipped_wakes,
+        "spawning onto an idle runtime should either wake a worker or skip the wake for a searcher");
+
+    ASCO_SUCCESS();
+}
+
+namespace {
+
+// n 个任务反复在同一个条件变量上挂起并被一起唤醒，返回完成的唤醒次数
+// 每轮通知前等待有 worker 进入休眠，使被唤醒的 execution 能够迁移到休眠的 worker 上
+future<std::size_t> run_wake_rounds(core::runtime &rt, std::size_t n, std::size_t rounds) {
+    sync::condition_variable cv;
+    std::atomic_size_t round{0};
+    std::atomic_size_t done{0};
+
+    std::vector<join_handle<void>> hs;
+    hs.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        hs.push_back(rt.spawn([&]() -> future<void> {
+            for (std::size_t r = 1; r <= rounds; ++r) {
+                co_await cv.wait([&] { return round.load(std::memory_order::acquire) >= r; });
+                co_await this_task::yield();
+                done.fetch_add(1, std::memory_order::acq_rel);
+            }
+        }));
+    }
+
+    for (std::size_t r = 1; r <= rounds; ++r) {
+        auto parks = rt.get_park_stats().parks;
+        co_await test::wait_until(
+            [&] { return rt.get_park_stats().parks > parks; }, std::chrono::milliseconds{100});
+        round.store(r, std::memory_order::release);
+        cv.notify();
+        while (done.load(std::memory_order::acquire) < r * n) {
+            co_await this_task::yield();
+        }
+    }
+    for (auto &h : hs) {
+        co_await h;
+    }
+
+    co_return done.load();
+}
+
+}  // namespace
+
+ASCO_TEST(runtime_repeatedly_woken_tasks_all_complete) {
+    core::runtime rt = core::runtime_builder::multi_threaded(4).build();
+
+    constexpr std::size_t n = 64;
+    constexpr std::size_t rounds = 50;
+
+    auto before = rt.get_park_stats();
+    auto done = co_await run_wake_rounds(rt, n, rounds);
+    ASCO_CHECK(done == n * rounds, "all wakes should be delivered, got {}", done);
+
+    // 休眠的 worker 被唤醒后应从繁忙的 worker 接过活动的 execution
+    auto after = rt.get_park_stats();
+    ASCO_CHECK(
+        after.migrations > before.migrations, "woken executions should migrate to parked workers, got {}",
+        after.migrations - before.migrations);
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(runtime_mlfq_scheduler_runs_yielding_and_waking_tasks) {
+    core::runtime rt =
+        core::runtime_builder::multi_threaded(2).with_scheduler<core::task::mlfq_scheduler>().build();
+
+    constexpr std::size_t n = 64;
+    constexpr std::size_t rounds = 20;
+
+    // 跨线程唤醒与 mlfq_context::end 中的挂起相互竞争
+    auto done = co_await run_wake_rounds(rt, n, rounds);
+    ASCO_CHECK(done == n * rounds, "all wakes should be delivered, got {}", done);
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(runtime_spawn_many_returns_results_in_order) {
+    constexpr std::size_t n = 1000;
+
+    auto group = spawn_many(std::views::iota(std::size_t{0}, n) | std::views::transform([](std::size_t i) {
+                                return [i]() -> future<std::size_t> {
+                                    co_await this_task::yield();
+                                    co_return i * 2;
+                                };
+                            }));
+    ASCO_CHECK(group.size() == n, "group size should equal range size, got {}", group.size());
+
+    auto res = co_await group.join_all();
+    ASCO_CHECK(res.size() == n, "join_all should return one result per task, got {}", res.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        ASCO_CHECK(res[i] == i * 2, "result #{} should be {}, got {}", i, i * 2, res[i]);
+    }
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(runtime_spawn_many_rethrows_task_exception) {
+    std::vector<std::function<future<void>()>> fns;
+    std::atomic_size_t done{0};
+    for (std::size_t i = 0; i < 16; ++i) {
+        fns.push_back([i, &done]() -> future<void> {
+            done.fetch_add(1, std::memory_order::acq_rel);
+            if (i == 7) {
+                throw std::runtime_error{"task 7 failed"};
+            }
+            co_return;
+        });
+    }
+
+    auto group = spawn_many(fns);
+    bool thrown = false;
+    try {
+        co_await group.join_all();
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+
+    ASCO_CHECK(thrown, "join_all should rethrow the exception thrown by a task");
+    ASCO_CHECK(done.load() == 16, "all tasks should have run, got {}", done.load());
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(runtime_spawn_blocking_runs_off_worker) {
+    auto h = spawn_blocking([]() {
+        return this_task::is_blocking_env() && core::worker::try_current() == nullptr;
+    });
+
+    ASCO_CHECK(co_await h, "spawn_blocking closure should run on a blocking thread instead of a worker");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(runtime_spawn_blocking_does_not_starve_single_worker) {
+    core::runtime rt = core::runtime_builder::single_threaded().build();
+
+    // 阻塞闭包一直占用线程，唯一的 worker 仍然要能继续推进异步任务
+    std::atomic_bool release{false};
+    auto blocker = rt.spawn_blocking([&release]() {
+        while (!release.load(std::memory_order::acquire)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+    });
+    auto h = rt.spawn([&release]() -> future<int> {
+        co_await this_task::yield();
+        release.store(true, std::memory_order::release);
+        co_return 7;
+    });
+
+    ASCO_CHECK(co_await h == 7, "async task should complete while a blocking closure is running");
+    co_await blocker;
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(runtime_drop_runs_queued_blocking_jobs) {
+    constexpr std::size_t n = 4;
+    std::atomic_size_t ran{0};
+    std::vector<join_handle<void>> hs;
+    {
+        core::runtime rt = core::runtime_builder::single_threaded()  //
+                               .with_blocking_threads(1)
+                               .build();
+        // 唯一的阻塞线程被占住，其余任务留在队列中直到 runtime 析构
+        hs.push_back(rt.spawn_blocking([&ran]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+            ran.fetch_add(1, std::memory_order::relaxed);
+        }));
+        for (std::size_t i = 1; i < n; ++i) {
+            hs.push_back(rt.spawn_blocking([&ran]() { ran.fetch_add(1, std::memory_order::relaxed); }));
+        }
+    }
+
+    ASCO_CHECK(
+        ran.load() == n, "queued blocking jobs should run before the runtime is dropped, got {}", ran.load());
+    for (auto &h : hs) {
+        co_await h;
+    }
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(runtime_drop_runs_blocking_jobs_spawned_during_teardown) {
+    std::atomic_size_t nested{0};
+    std::atomic_bool off_worker{true};
+    {
+        core::runtime rt = core::runtime_builder::single_threaded()  //
+                               .with_blocking_threads(1)
+                               .build();
+        auto blocker =
+            rt.spawn_blocking([]() { std::this_thread::sleep_for(std::chrono::milliseconds{20}); });
+        // 排在队列中的任务在 runtime 析构期间才运行，此时它再提交的阻塞任务也要运行完
+        auto spawner = rt.spawn_blocking([&nested, &off_worker]() {
+            auto h = spawn_blocking([&nested, &off_worker]() {
+                if (!this_task::is_blocking_env()) {
+                    off_worker.store(false, std::memory_order::relaxed);
+                }
+                nested.fetch_add(1, std::memory_order::relaxed);
+            });
+            (void)h;
+        });
+    }
+
+    ASCO_CHECK(nested.load() == 1, "blocking work spawned during teardown should still run");
+    ASCO_CHECK(off_worker.load(), "blocking work drained during teardown should not run on a worker");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(runtime_spawn_blocking_rethrows_exception) {
+    auto h = spawn_blocking([]() -> int { throw std::runtime_error{"blocking failed"}; });
+
+    bool thrown = false;
+    try {
+        co_await h;
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    ASCO_CHECK(thrown, "exception thrown by a blocking closure should be rethrown on join");
+
+    ASCO_SUCCESS();
+}
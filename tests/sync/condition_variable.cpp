@@ -8,6 +8,9 @@
 
 #include "../async_test_utils.h"
 
+#include <asco/core/cancellation.h>
+#include <asco/core/runtime.h>
+#include <asco/join_handle.h>
 #include <asco/sync/condition_variable.h>
 #include <asco/test/test.h>
 
@@ -294,3 +297,104 @@ ASCO_TEST(condition_variable_predicated_notify_wakes_at_most_n_waiters) {
 
     ASCO_SUCCESS();
 }
+
+ASCO_TEST(condition_variable_notify_all_wakes_waiters_beyond_one_batch) {
+    constexpr std::size_t waiter_count = 40;
+
+    sync::condition_variable cv;
+    std::atomic_bool ready{false};
+    std::atomic_size_t queued{0};
+    std::atomic_size_t resumed{0};
+
+    std::vector<join_handle<void>> waiters;
+    waiters.reserve(waiter_count);
+    for (std::size_t i = 0; i < waiter_count; ++i) {
+        waiters.push_back(spawn([&]() -> future<void> {
+            co_await cv.wait([&]() {
+                if (ready.load(std::memory_order::acquire)) {
+                    return true;
+                }
+                queued.fetch_add(1, std::memory_order::acq_rel);
+                return false;
+            });
+            resumed.fetch_add(1, std::memory_order::acq_rel);
+        }));
+    }
+
+    ASCO_CHECK(
+        co_await test::wait_until([&]() { return queued.load(std::memory_order::acquire) >= waiter_count; }),
+        "all waiters should enqueue before notify()");
+
+    ready.store(true, std::memory_order::release);
+    ASCO_CHECK(cv.notify() == waiter_count, "notify() should wake every queued waiter across batches");
+    ASCO_CHECK(
+        co_await test::wait_until(
+            [&]() { return resumed.load(std::memory_order::acquire) == waiter_count; }),
+        "every waiter should resume after notify()");
+
+    for (auto &waiter : waiters) {
+        co_await waiter;
+    }
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(condition_variable_cancelled_waiter_leaves_the_queue) {
+    sync::condition_variable cv;
+
+    auto waiter = spawn([&]() -> future<void> { co_await cv.wait([]() { return false; }); });
+
+    ASCO_CHECK(co_await wait_until_waiter_queued(cv), "waiter should enqueue itself before cancellation");
+
+    waiter.cancel();
+    bool cancelled = false;
+    try {
+        co_await waiter;
+    } catch (core::coroutine_cancelled &) { cancelled = true; }
+    ASCO_CHECK(cancelled, "awaiting the cancelled waiter should throw coroutine_cancelled");
+
+    ASCO_CHECK(!cv.notify_one(), "a cancelled waiter should no longer be in the wait queue");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(condition_variable_waiter_rewaits_after_migration) {
+    core::runtime rt = core::runtime_builder::multi_threaded(4).build();
+
+    constexpr std::size_t n = 32;
+    constexpr std::size_t steps = 64;
+
+    sync::condition_variable cv;
+    std::atomic_size_t step{0};
+    std::atomic_size_t done{0};
+
+    // 每一步都唤醒所有等待者，但只有目标步数已到的任务通过，其余任务被唤醒后（可能已被迁移）重新挂起
+    auto before = rt.get_park_stats();
+    std::vector<join_handle<void>> hs;
+    hs.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        auto target = steps * (i + 1) / n;
+        hs.push_back(rt.spawn([&, target]() -> future<void> {
+            co_await cv.wait([&] { return step.load(std::memory_order::acquire) >= target; });
+            done.fetch_add(1, std::memory_order::acq_rel);
+        }));
+    }
+    for (std::size_t s = 1; s <= steps; ++s) {
+        auto parks = rt.get_park_stats().parks;
+        co_await test::wait_until(
+            [&] { return rt.get_park_stats().parks > parks; }, std::chrono::milliseconds{20});
+        step.store(s, std::memory_order::release);
+        cv.notify();
+    }
+    for (auto &h : hs) {
+        co_await h;
+    }
+
+    auto after = rt.get_park_stats();
+    ASCO_CHECK(done.load() == n, "every waiter should eventually pass its predicate, got {}", done.load());
+    ASCO_CHECK(
+        after.migrations > before.migrations, "woken waiters should migrate between workers, got {}",
+        after.migrations - before.migrations);
+
+    ASCO_SUCCESS();
+}
@@ -4,11 +4,16 @@
 #include <atomic>
 #include <cstddef>
 #include <utility>
+#include <vector>
 
 #include "../async_test_utils.h"
 
+#include <asco/core/cancellation.h>
+#include <asco/core/runtime.h>
+#include <asco/join_handle.h>
 #include <asco/sync/mutex.h>
 #include <asco/test/test.h>
+#include <asco/yield.h>
 
 using namespace asco;
 
@@ -64,6 +69,148 @@ ASCO_TEST(mutex_void_lock_blocks_and_release_wakes) {
     ASCO_SUCCESS();
 }
 
+ASCO_TEST(mutex_void_contended_critical_sections_are_exclusive) {
+    constexpr std::size_t tasks = 16;
+    constexpr std::size_t rounds = 200;
+
+    sync::mutex<> m;
+    std::size_t counter = 0;
+    std::atomic_size_t inside{0};
+    std::atomic_bool overlapped{false};
+
+    std::vector<join_handle<void>> hs;
+    hs.reserve(tasks);
+    for (std::size_t i = 0; i < tasks; ++i) {
+        hs.push_back(spawn([&]() -> future<void> {
+            for (std::size_t r = 0; r < rounds; ++r) {
+                auto g = co_await m.lock();
+                if (inside.fetch_add(1, std::memory_order::acq_rel) != 0) {
+                    overlapped.store(true, std::memory_order::release);
+                }
+                ++counter;
+                // 在临界区内让出，迫使其它任务进入等待队列
+                if (r % 8 == 0) {
+                    co_await this_task::yield();
+                }
+                inside.fetch_sub(1, std::memory_order::acq_rel);
+            }
+        }));
+    }
+    for (auto &h : hs) {
+        co_await h;
+    }
+
+    ASCO_CHECK(!overlapped.load(), "two tasks should never hold the mutex at the same time");
+    ASCO_CHECK(counter == tasks * rounds, "every increment should be kept, got {}", counter);
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(mutex_void_contended_lock_survives_migration) {
+    core::runtime rt = core::runtime_builder::multi_threaded(4).build();
+
+    constexpr std::size_t tasks = 32;
+    constexpr std::size_t rounds = 200;
+
+    sync::mutex<> m;
+    std::size_t counter = 0;
+
+    // 大部分任务挂在等待队列中，空闲的 worker 休眠；被唤醒却没抢到锁的等待者可能已被迁移，随后重新挂起
+    auto before = rt.get_park_stats();
+    std::vector<join_handle<void>> hs;
+    hs.reserve(tasks);
+    for (std::size_t i = 0; i < tasks; ++i) {
+        hs.push_back(rt.spawn([&]() -> future<void> {
+            for (std::size_t r = 0; r < rounds; ++r) {
+                {
+                    auto g = co_await m.lock();
+                    auto v = counter;
+                    co_await this_task::yield();
+                    counter = v + 1;
+                }
+                co_await this_task::yield();
+            }
+        }));
+    }
+    for (auto &h : hs) {
+        co_await h;
+    }
+
+    auto after = rt.get_park_stats();
+    ASCO_CHECK(counter == tasks * rounds, "every increment should be kept, got {}", counter);
+    ASCO_CHECK(
+        after.migrations > before.migrations, "contended waiters should migrate between workers, got {}",
+        after.migrations - before.migrations);
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(mutex_void_hands_off_to_long_waiting_waiter) {
+    sync::mutex<> m;
+
+    std::atomic_bool attempted{false};
+    std::atomic_bool entered{false};
+
+    auto holder = co_await m.lock();
+    auto waiter = spawn([&]() -> future<void> {
+        attempted.store(true, std::memory_order::release);
+        auto g = co_await m.lock();
+        entered.store(true, std::memory_order::release);
+    });
+
+    ASCO_CHECK(
+        co_await test::wait_until([&]() { return attempted.load(std::memory_order::acquire); }),
+        "waiter did not attempt lock() in time");
+    // 等待时间远超 barging_window
+    ASCO_CHECK(
+        co_await test::stays_false_for([&]() { return entered.load(std::memory_order::acquire); }),
+        "lock() should block while mutex is held");
+
+    holder = {};
+    ASCO_CHECK(!m.try_lock(), "ownership should be handed to the waiter instead of being released");
+
+    co_await waiter;
+    ASCO_CHECK(entered.load(), "waiter should own the mutex after hand-off");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(mutex_void_cancelled_waiter_leaves_the_queue) {
+    sync::mutex<> m;
+
+    std::atomic_bool attempted{false};
+    std::atomic_bool entered{false};
+
+    auto holder = co_await m.lock();
+    auto waiter = spawn([&]() -> future<void> {
+        attempted.store(true, std::memory_order::release);
+        auto g = co_await m.lock();
+        entered.store(true, std::memory_order::release);
+    });
+
+    ASCO_CHECK(
+        co_await test::wait_until([&]() { return attempted.load(std::memory_order::acquire); }),
+        "waiter did not attempt lock() in time");
+    ASCO_CHECK(
+        co_await test::stays_false_for([&]() { return entered.load(std::memory_order::acquire); }),
+        "waiter should stay parked on the mutex");
+    ASCO_CHECK(!m.try_lock(), "try_lock() should fail while the holder keeps the mutex");
+
+    waiter.cancel();
+    bool cancelled = false;
+    try {
+        co_await waiter;
+    } catch (core::coroutine_cancelled &) { cancelled = true; }
+    ASCO_CHECK(cancelled, "awaiting the cancelled waiter should throw coroutine_cancelled");
+
+    holder = {};
+    ASCO_CHECK(
+        co_await test::wait_until([&]() { return static_cast<bool>(m.try_lock()); }),
+        "mutex should become free once the only waiter was cancelled");
+
+    ASCO_SUCCESS();
+}
+
 ASCO_TEST(mutex_t_lock_allows_access_and_mutation) {
     sync::mutex<int> m{41};
 
@@ -0,0 +1,169 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "../async_test_utils.h"
+
+#include <asco/sync/scalable_rwlock.h>
+#include <asco/test/test.h>
+
+using namespace asco;
+
+ASCO_TEST(scalable_rwlock_void_try_read_try_write_and_raii_release) {
+    sync::scalable_rwlock<> lock;
+
+    auto r1 = lock.try_read();
+    ASCO_CHECK(r1, "try_read() should succeed on an unlocked scalable_rwlock");
+
+    auto r2 = lock.try_read();
+    ASCO_CHECK(r2, "try_read() should allow multiple readers concurrently");
+
+    auto w1 = lock.try_write();
+    ASCO_CHECK(!w1, "try_write() should fail while biased readers are holding the lock");
+
+    r1 = {};
+    r2 = {};
+
+    auto w2 = lock.try_write();
+    ASCO_CHECK(w2, "try_write() should succeed after the last reader releases");
+    ASCO_CHECK(!lock.try_read(), "try_read() should fail while a writer holds the lock");
+    ASCO_CHECK(!lock.try_write(), "try_write() should fail while a writer already holds the lock");
+
+    w2 = {};
+
+    auto r3 = lock.try_read();
+    ASCO_CHECK(r3, "try_read() should succeed again after the writer releases");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(scalable_rwlock_void_write_waits_for_biased_readers) {
+    sync::scalable_rwlock<> lock;
+
+    auto reader1 = co_await lock.read();
+    auto reader2 = co_await lock.read();
+
+    std::atomic_bool writer_attempted{false};
+    std::atomic_bool writer_entered{false};
+
+    auto writer = spawn([&]() -> future<void> {
+        writer_attempted.store(true, std::memory_order::release);
+        auto g = co_await lock.write();
+        (void)g;
+        writer_entered.store(true, std::memory_order::release);
+    });
+
+    ASCO_CHECK(
+        co_await test::wait_until([&]() { return writer_attempted.load(std::memory_order::acquire); }),
+        "writer did not attempt write() in time");
+    ASCO_CHECK(
+        co_await test::stays_false_for([&]() { return writer_entered.load(std::memory_order::acquire); }),
+        "write() should wait while readers are present");
+    ASCO_CHECK(!lock.try_read(), "new readers should not enter while a writer is revoking the read bias");
+
+    reader1 = {};
+
+    ASCO_CHECK(
+        co_await test::stays_false_for([&]() { return writer_entered.load(std::memory_order::acquire); }),
+        "write() should still wait until the last active reader releases");
+
+    reader2 = {};
+
+    ASCO_CHECK(
+        co_await test::wait_until([&]() { return writer_entered.load(std::memory_order::acquire); }),
+        "writer should enter after every reader has released the lock");
+
+    co_await writer;
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(scalable_rwlock_void_upgrade_transfers_biased_reader_to_writer) {
+    sync::scalable_rwlock<> lock;
+
+    auto reader = co_await lock.read();
+
+    auto writer = co_await std::move(reader).upgrade();
+    ASCO_CHECK(!reader, "upgrade() should consume the source read guard");
+    ASCO_CHECK(writer, "upgrade() should produce a valid write guard when this is the last reader");
+    ASCO_CHECK(!lock.try_read(), "try_read() should fail while the upgraded writer holds the lock");
+    ASCO_CHECK(!lock.try_write(), "try_write() should fail while the upgraded writer holds the lock");
+
+    writer = {};
+
+    auto reader2 = co_await lock.read();
+    ASCO_CHECK(
+        reader2, "readers should be able to acquire the lock again after the upgraded writer releases");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(scalable_rwlock_t_many_readers_and_writers_keep_value_consistent) {
+    constexpr std::size_t tasks = 16;
+    constexpr std::size_t ops = 200;
+
+    sync::scalable_rwlock<std::size_t> lock{0};
+    std::atomic_bool torn{false};
+
+    std::vector<join_handle<void>> handles;
+    for (std::size_t i = 0; i < tasks; ++i) {
+        handles.push_back(spawn([&, i]() -> future<void> {
+            for (std::size_t j = 0; j < ops; ++j) {
+                if ((i + j) % 10 == 0) {
+                    auto g = co_await lock.write();
+                    auto before = *g;
+                    *g = before + 1;
+                    if (*g != before + 1) {
+                        torn.store(true, std::memory_order::relaxed);
+                    }
+                } else {
+                    auto g = co_await lock.read();
+                    auto seen = *g;
+                    if (*g != seen) {
+                        torn.store(true, std::memory_order::relaxed);
+                    }
+                }
+            }
+        }));
+    }
+    for (auto &h : handles) {
+        co_await h;
+    }
+
+    std::size_t writes = 0;
+    for (std::size_t i = 0; i < tasks; ++i) {
+        for (std::size_t j = 0; j < ops; ++j) {
+            writes += (i + j) % 10 == 0;
+        }
+    }
+
+    auto g = co_await lock.read();
+    ASCO_CHECK(!torn.load(std::memory_order::relaxed), "readers should never observe a concurrent write");
+    ASCO_CHECK(*g == writes, "every write should be applied exactly once");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(scalable_rwlock_t_upgrade_allows_mutating_bound_value) {
+    sync::scalable_rwlock<int> lock{41};
+
+    auto reader = co_await lock.read();
+    ASCO_CHECK(*reader == 41, "read guard should expose the current value before upgrade()");
+
+    auto writer = co_await std::move(reader).upgrade();
+    ASCO_CHECK(!reader, "upgrade() should consume scalable_rwlock<T>::read_guard");
+    ASCO_CHECK(writer, "upgrade() should produce scalable_rwlock<T>::write_guard");
+
+    *writer = 42;
+
+    writer = {};
+
+    auto reader2 = co_await lock.read();
+    ASCO_CHECK(*reader2 == 42, "mutation through an upgraded writer guard should persist after release");
+
+    ASCO_SUCCESS();
+}
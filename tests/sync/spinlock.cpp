@@ -0,0 +1,92 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <asco/sync/mcs_spinlock.h>
+#include <asco/sync/ticket_spinlock.h>
+#include <asco/test/test.h>
+
+using namespace asco;
+
+namespace {
+
+// threads 个线程各自加锁 iterations 次递增计数，返回最终计数
+template<typename Lock>
+std::size_t contend(std::size_t threads, std::size_t iterations) {
+    Lock lock{std::size_t{0}};
+    std::vector<std::thread> ts;
+    for (std::size_t i = 0; i < threads; ++i) {
+        ts.emplace_back([&] {
+            for (std::size_t j = 0; j < iterations; ++j) {
+                auto g = lock.lock();
+                ++*g;
+            }
+        });
+    }
+    for (auto &t : ts) {
+        t.join();
+    }
+    return *lock.lock();
+}
+
+}  // namespace
+
+ASCO_TEST(mcs_spinlock_try_lock_and_raii_release) {
+    sync::mcs_spinlock<> lock;
+
+    auto g1 = lock.try_lock();
+    ASCO_CHECK(g1, "try_lock() should succeed on an unlocked mcs_spinlock");
+    ASCO_CHECK(!lock.try_lock(), "try_lock() should fail while the lock is held");
+
+    auto g2 = std::move(g1);
+    ASCO_CHECK(!g1, "moved-from guard should be empty");
+    ASCO_CHECK(!lock.try_lock(), "moving the guard should keep the lock held");
+
+    g2 = {};
+    ASCO_CHECK(lock.try_lock(), "try_lock() should succeed after the guard releases");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(mcs_spinlock_excludes_concurrent_threads) {
+    constexpr std::size_t threads = 4;
+    constexpr std::size_t iterations = 5'000;
+
+    ASCO_CHECK(
+        contend<sync::mcs_spinlock<std::size_t>>(threads, iterations) == threads * iterations,
+        "every increment under mcs_spinlock should be applied exactly once");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(ticket_spinlock_try_lock_and_raii_release) {
+    sync::ticket_spinlock<> lock;
+
+    auto g1 = lock.try_lock();
+    ASCO_CHECK(g1, "try_lock() should succeed on an unlocked ticket_spinlock");
+    ASCO_CHECK(!lock.try_lock(), "try_lock() should fail while the lock is held");
+
+    auto g2 = std::move(g1);
+    ASCO_CHECK(!g1, "moved-from guard should be empty");
+    ASCO_CHECK(!lock.try_lock(), "moving the guard should keep the lock held");
+
+    g2 = {};
+    ASCO_CHECK(lock.try_lock(), "try_lock() should succeed after the guard releases");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(ticket_spinlock_excludes_concurrent_threads) {
+    constexpr std::size_t threads = 4;
+    constexpr std::size_t iterations = 5'000;
+
+    ASCO_CHECK(
+        contend<sync::ticket_spinlock<std::size_t>>(threads, iterations) == threads * iterations,
+        "every increment under ticket_spinlock should be applied exactly once");
+
+    ASCO_SUCCESS();
+}
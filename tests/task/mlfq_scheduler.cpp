@@ -0,0 +1,68 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <asco/core/task/execution_domain.h>
+#include <asco/core/task/mlfq_scheduler.h>
+#include <asco/test/test.h>
+#include <asco/util/tsc.h>
+
+using namespace asco;
+
+ASCO_TEST(mlfq_scheduler_demotes_cpu_bound_execution_and_ages_it_back) {
+    using core::task::execution;
+    using core::task::mlfq_scheduler;
+
+    // 多个交互式 execution 分摊时间片，个别被系统抢占而降级时最高级仍不为空
+    constexpr std::size_t interactive_count = 8;
+
+    mlfq_scheduler s;
+    core::task::execution_domain domain{s};
+    s.bind_execution_domain(domain);
+
+    execution cpu_bound{std::noop_coroutine()};
+    std::vector<std::unique_ptr<execution>> interactive;
+    s.attach_execution(cpu_bound);
+    for (std::size_t i = 0; i < interactive_count; ++i) {
+        s.attach_execution(*interactive.emplace_back(std::make_unique<execution>(std::noop_coroutine())));
+    }
+
+    // 调度并运行一次：CPU 密集的 execution 用掉两倍最高级时间片，交互式的立即让出
+    auto run_once = [&]() -> execution * {
+        auto [exec, ctx] = s.schedule();
+        ctx.begin();
+        if (&exec == &cpu_bound) {
+            auto start = util::get_tsc();
+            while (util::get_tsc() - start < mlfq_scheduler::base_quantum * 2) {}
+        }
+        ctx.end(false);
+        return &exec;
+    };
+
+    ASCO_CHECK(run_once() == &cpu_bound, "the first attached execution should be scheduled first");
+
+    // 第 aging_period 次调度之前，降级后的 execution 不应抢在交互式 execution 之前运行
+    for (std::size_t tick = 2; tick < mlfq_scheduler::aging_period; ++tick) {
+        ASCO_CHECK(
+            run_once() != &cpu_bound,
+            "a demoted cpu-bound execution should wait while interactive ones are ready (tick {})", tick);
+    }
+
+    // 老化把所有 execution 提升回最高级，降级的 execution 排在已就绪的交互式 execution 之后
+    bool resumed = false;
+    for (std::size_t i = 0; i <= interactive_count + 1 && !resumed; ++i) {
+        resumed = run_once() == &cpu_bound;
+    }
+    ASCO_CHECK(resumed, "aging should bring the demoted execution back to the top level");
+
+    s.detach_execution(cpu_bound);
+    for (auto &e : interactive) {
+        s.detach_execution(*e);
+    }
+
+    ASCO_SUCCESS();
+}
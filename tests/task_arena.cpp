@@ -0,0 +1,96 @@
+// Copyright (C) 2026 pointer-to-bios <pointer-to-bios@outlook.com>
+// SPDX-License-Identifier: MIT
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <asco/core/mm/task_arena.h>
+#include <asco/core/runtime.h>
+#include <asco/io/buffer.h>
+#include <asco/test/test.h>
+#include <asco/this_task.h>
+#include <asco/yield.h>
+
+using namespace asco;
+
+namespace {
+
+struct arena_result {
+    std::uintptr_t before;
+    std::uintptr_t after;
+    std::size_t allocated;
+    std::size_t chunks;
+    bool contents_intact;
+};
+
+}  // namespace
+
+ASCO_TEST(task_arena_is_stable_within_a_task_and_serves_pmr_containers) {
+    auto h = spawn([]() -> future<arena_result> {
+        auto &arena = this_task::arena();
+        auto before = reinterpret_cast<std::uintptr_t>(&arena);
+
+        std::pmr::vector<std::pmr::string> strings{&arena};
+        for (std::size_t i = 0; i < 256; ++i) {
+            strings.emplace_back(std::string_view{"a string long enough to skip the small string buffer"});
+        }
+        io::buffer<> buf{std::string_view{"arena"}, arena.allocator()};
+        co_await this_task::yield();
+
+        auto after = reinterpret_cast<std::uintptr_t>(&this_task::arena());
+        bool intact = std::string_view{reinterpret_cast<const char *>(buf.data()), buf.cursor()} == "arena";
+        for (auto &s : strings) {
+            intact = intact && s.size() == 52;
+        }
+        co_return arena_result{before, after, arena.allocated_bytes(), arena.chunk_count(), intact};
+    });
+
+    auto r = co_await h;
+
+    ASCO_CHECK(r.before == r.after, "this_task::arena() should return the same arena across suspension");
+    ASCO_CHECK(
+        r.allocated > 256 * 52, "arena should serve the container allocations, got {} bytes", r.allocated);
+    ASCO_CHECK(r.chunks > 1, "arena should grow beyond its first chunk, got {} chunks", r.chunks);
+    ASCO_CHECK(r.contents_intact, "arena allocations should keep their contents");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(task_arena_is_separate_per_task) {
+    auto parent = spawn([]() -> future<bool> {
+        auto &mine = this_task::arena();
+        auto child = spawn([]() -> future<std::uintptr_t> {
+            co_return reinterpret_cast<std::uintptr_t>(&this_task::arena());
+        });
+        auto theirs = co_await child;
+        co_return theirs != reinterpret_cast<std::uintptr_t>(&mine);
+    });
+
+    ASCO_CHECK(co_await parent, "spawned tasks should get their own arena");
+
+    ASCO_SUCCESS();
+}
+
+ASCO_TEST(task_arena_handles_large_and_overaligned_allocations) {
+    auto arena = core::mm::task_arena::create();
+    ASCO_CHECK(arena != nullptr, "task_arena::create should succeed");
+
+    auto small = arena->allocate(16);
+    auto large = arena->allocate(core::mm::task_arena::max_chunk_size * 2);
+    auto aligned = arena->allocate(64, 256);
+    auto after = arena->allocate(16);
+
+    ASCO_CHECK(
+        reinterpret_cast<std::uintptr_t>(aligned) % 256 == 0, "over-aligned allocation should be aligned");
+    ASCO_CHECK(
+        static_cast<std::byte *>(after) - static_cast<std::byte *>(small) < 4096,
+        "a large allocation should not waste the current chunk");
+    std::fill_n(static_cast<std::byte *>(large), core::mm::task_arena::max_chunk_size * 2, std::byte{1});
+
+    ASCO_SUCCESS();
+}
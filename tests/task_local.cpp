@@ -7,6 +7,7 @@
 #include <utility>
 
 #include <asco/core/runtime.h>
+#include <asco/task/join_all.h>
 #include <asco/test/test.h>
 #include <asco/this_task.h>
 #include <asco/yield.h>
@@ -123,6 +124,26 @@ ASCO_TEST(task_local_isolated_between_parent_and_child_tasks) {
     ASCO_SUCCESS();
 }
 
+ASCO_TEST(task_local_shared_with_join_all_branches) {
+    auto h = spawn(
+        []() -> future<int> {
+            auto [a, b] = co_await task::join_all{
+                []() -> future<int> { co_return this_task::task_local<tls_int>().value; },
+                []() -> future<int> {
+                    co_await this_task::yield();
+                    co_return this_task::task_local<tls_int>().value + 1;
+                }};
+            co_return *a + *b;
+        },
+        tls_int{7});
+
+    auto r = co_await h;
+
+    ASCO_CHECK(r == 15, "join_all branches should see the enclosing task's TLS, got {}", r);
+
+    ASCO_SUCCESS();
+}
+
 ASCO_TEST(task_local_destroyed_after_join_handle_released) {
     std::atomic_int dtors{0};
 